@@ -3,6 +3,8 @@
 #ifndef ESAT_BLACKJACK_INTERFACES_ITABLE_H
 #define ESAT_BLACKJACK_INTERFACES_ITABLE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 /**
@@ -42,7 +44,7 @@ class ITable {
          * @enum Value
          * @brief Card values in the deck.
          */
-        enum class Value {
+        enum class Value : std::uint8_t {
             ACE = 1, ///< Ace (can be 1 or 11)
             TWO,     ///< Two
             THREE,   ///< Three
@@ -63,7 +65,7 @@ class ITable {
          * @enum Suit
          * @brief Card suits in the deck.
          */
-        enum class Suit {
+        enum class Suit : std::uint8_t {
             HEARTS,   ///< Hearts suit
             CLUBS,    ///< Clubs suit
             SPADES,   ///< Spades suit
@@ -74,15 +76,53 @@ class ITable {
         /**
          * @struct Card
          * @brief Represents a playing card with value and suit.
+         *
+         * Both fields are packed into a single byte, so shoes and hands
+         * store one byte per card.
          */
         struct Card {
-            Value value_; ///< The card's value
-            Suit suit_;   ///< The card's suit
+            Value value_ : 4; ///< The card's value
+            Suit suit_ : 4;   ///< The card's suit
         };
 
+        static_assert(sizeof(Card) == 1, "Card must stay packed in one byte");
+
         /// Type alias for a hand of cards
         using Hand = std::vector<Card>;
 
+        /**
+         * @struct HandView
+         * @brief Non-owning, read-only view over the cards of a hand.
+         *
+         * Points into the table's own storage, so reading it never allocates.
+         * A view stays valid until the hand it refers to changes (a card is
+         * dealt, the hand is split or a new round starts).
+         */
+        struct HandView {
+            const Card* cards_ = nullptr; ///< First card of the hand
+            int count_ = 0;               ///< Number of cards in the hand
+
+            const Card* begin() const { return cards_; }
+            const Card* end() const { return cards_ + count_; }
+            const Card* data() const { return cards_; }
+            int size() const { return count_; }
+            bool empty() const { return count_ == 0; }
+            const Card& operator[](int index) const { return cards_[index]; }
+        };
+
+        /**
+         * @struct HandSummary
+         * @brief Precomputed state of a hand, read without touching its cards.
+         */
+        struct HandSummary {
+            int score = 0;          ///< Best total under the table's win point
+            int cards = 0;          ///< Number of cards in the hand
+            bool soft = false;      ///< At least one ace counts as 11
+            bool pair = false;      ///< Exactly two cards of the same value
+            bool blackjack = false; ///< Two cards totalling the win point
+            bool bust = false;      ///< Total over the win point
+        };
+
         /**
          * @struct RoundEndInfo
          * @brief Information about the end of a round.
@@ -102,18 +142,77 @@ class ITable {
             int croupier_money_delta;             ///< Money won or lost by the dealer in this round
         };
 
+        /**
+         * @struct RoundResults
+         * @brief Caller-owned, reusable settlement of a round.
+         *
+         * Same information as @ref RoundEndInfo, but the per-hand results are
+         * stored flat as [player_index * hand_stride + hand_index]. Passing the
+         * same object to @ref SettleRound every round reuses its buffers, so
+         * steady-state rounds make no heap allocations.
+         */
+        struct RoundResults {
+            Hand dealer_hand;                                ///< The dealer's final hand
+            std::vector<RoundEndInfo::BetResult> winners;    ///< Flat [player][hand] results
+            std::vector<int> hand_counts;                    ///< Number of hands of each player
+            std::vector<int> player_money_delta;             ///< Money won by each player in this round
+            int croupier_money_delta = 0;                    ///< Money won or lost by the dealer in this round
+            int hand_stride = 0;                             ///< Row length of @ref winners
+            std::vector<int> hand_bets;                      ///< Flat [player][hand] stakes, same layout as @ref winners
+            std::vector<int> insurance_bets;                 ///< Insurance (safe) bet of each player
+
+            /**
+             * @brief Gets the result of one hand.
+             * @param player_index Index of the player
+             * @param hand_index Index of the hand (below hand_counts[player_index])
+             */
+            RoundEndInfo::BetResult Winner(int player_index, int hand_index) const {
+                return winners[player_index * hand_stride + hand_index];
+            }
+        };
+
         /// Maximum number of players at the table (reduce if running out of cards during a round)
         static const int kMaxPlayers = 7;
 
         /**
          * @brief Gets a specific hand for a player.
          *
+         * Returns an owning copy; prefer @ref GetHandView in hot paths.
+         *
          * @param player_index Index of the player
          * @param hand_index Index of the hand
          * @return Hand The requested hand
          */
         virtual Hand GetHand(int player_index,int hand_index) const = 0;
 
+        /**
+         * @brief Gets a non-owning view of a specific hand for a player.
+         *
+         * Tables written before this method existed can inherit
+         * @ref ITableAdapter, which implements it on top of @ref GetHand.
+         *
+         * @param player_index Index of the player
+         * @param hand_index Index of the hand
+         * @return HandView View over the hand's cards (empty if the indices are invalid)
+         */
+        virtual HandView GetHandView(int player_index,int hand_index) const = 0;
+
+        /**
+         * @brief Gets the precomputed score, soft and pair state of a hand.
+         *
+         * @param player_index Index of the player
+         * @param hand_index Index of the hand
+         * @return HandSummary Summary of the hand (all zero if the indices are invalid)
+         */
+        virtual HandSummary GetHandSummary(int player_index,int hand_index) const = 0;
+
+        /**
+         * @brief Gets a non-owning view of the dealer's current hand.
+         *
+         * @return HandView View over the dealer's cards
+         */
+        virtual HandView GetDealerHandView() const = 0;
+
         /**
          * @brief Gets the current number of hands for a player.
          *
@@ -219,6 +318,62 @@ class ITable {
          * @return RoundEndInfo Information about the round results
          */
         virtual RoundEndInfo FinishRound() = 0;
+
+        /**
+         * @brief Calculates the end of a round into a caller-owned buffer.
+         *
+         * Performs the same operations as @ref FinishRound, but writes the
+         * results into @p results, reusing its storage.
+         *
+         * The default reads the stakes through the interface, calls
+         * @ref FinishRound and flattens its result, so it allocates like
+         * @ref FinishRound does; insurance bets are not visible through the
+         * interface and are reported as 0.
+         *
+         * @param results Buffer overwritten with the round results
+         */
+        virtual void SettleRound(RoundResults& results) {
+            // Stakes are cleared by FinishRound, so read them first.
+            std::vector<int> stakes;
+            std::vector<int> stake_counts(kMaxPlayers, 0);
+            for (int player = 0; player < kMaxPlayers; ++player) {
+                stake_counts[player] = GetNumberOfHands(player);
+                for (int hand = 0; hand < stake_counts[player]; ++hand) {
+                    stakes.push_back(GetPlayerCurrentBet(player, hand));
+                }
+            }
+
+            const RoundEndInfo info = FinishRound();
+            const int players = static_cast<int>(info.winners.size());
+            results.dealer_hand = info.dealer_hand;
+            results.player_money_delta = info.player_money_delta;
+            results.croupier_money_delta = info.croupier_money_delta;
+            results.hand_counts.assign(players, 0);
+            results.hand_stride = 1;
+            for (int player = 0; player < players; ++player) {
+                results.hand_counts[player] = static_cast<int>(info.winners[player].size());
+                if (results.hand_counts[player] > results.hand_stride) {
+                    results.hand_stride = results.hand_counts[player];
+                }
+            }
+            const std::size_t cells = static_cast<std::size_t>(players) * results.hand_stride;
+            results.winners.assign(cells, RoundEndInfo::BetResult::Lose);
+            results.hand_bets.assign(cells, 0);
+            results.insurance_bets.assign(players, 0);
+            std::size_t stake = 0;
+            for (int player = 0; player < kMaxPlayers; ++player) {
+                for (int hand = 0; hand < stake_counts[player]; ++hand, ++stake) {
+                    if (player < players && hand < results.hand_counts[player]) {
+                        results.hand_bets[player * results.hand_stride + hand] = stakes[stake];
+                    }
+                }
+            }
+            for (int player = 0; player < players; ++player) {
+                for (int hand = 0; hand < results.hand_counts[player]; ++hand) {
+                    results.winners[player * results.hand_stride + hand] = info.winners[player][hand];
+                }
+            }
+        }
 };
 
 #endif // ESAT_BLACKJACK_INTERFACES_ITABLE_H
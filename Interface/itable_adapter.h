@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef ESAT_BLACKJACK_INTERFACES_ITABLE_ADAPTER_H
+#define ESAT_BLACKJACK_INTERFACES_ITABLE_ADAPTER_H
+
+#include "Interface/itable.h"
+
+/**
+ * @class ITableAdapter
+ * @brief Opt-in base for tables written against the original ITable.
+ *
+ * Implements the hand view and summary methods on top of @ref ITable::GetHand
+ * and @ref ITable::GetDealerCard, so such a table only has to inherit this
+ * class instead of ITable and pass its win point. The views are copies kept
+ * in the adapter: each one is valid until the next call of the same method,
+ * and a table read from several threads must override them with real views.
+ */
+class ITableAdapter : public ITable {
+    public:
+        /**
+         * @param win_point Score the table plays to (see BaseRules::GetWinPoint).
+         */
+        explicit ITableAdapter(int win_point) : win_point_(win_point) {}
+
+        /**
+         * @brief Copies @ref GetHand into the adapter and views the copy.
+         */
+        HandView GetHandView(int player_index,int hand_index) const override {
+            hand_buffer_ = GetHand(player_index, hand_index);
+            return HandView{hand_buffer_.data(), static_cast<int>(hand_buffer_.size())};
+        }
+
+        /**
+         * @brief Scores @ref GetHand against the table's win point.
+         */
+        HandSummary GetHandSummary(int player_index,int hand_index) const override {
+            const Hand hand = GetHand(player_index, hand_index);
+            HandSummary summary;
+            int hard = 0;
+            bool ace = false;
+            for (const Card& card : hand) {
+                const int value = static_cast<int>(card.value_);
+                hard += value > 10 ? 10 : value;
+                ace = ace || card.value_ == Value::ACE;
+            }
+            summary.cards = static_cast<int>(hand.size());
+            summary.soft = ace && hard + 10 <= win_point_;
+            summary.score = summary.soft ? hard + 10 : hard;
+            summary.pair = hand.size() == 2 && hand[0].value_ == hand[1].value_;
+            summary.blackjack = hand.size() == 2 && summary.score == win_point_;
+            summary.bust = summary.score > win_point_;
+            return summary;
+        }
+
+        /**
+         * @brief Views the dealer's face-up card, the only one ITable exposes.
+         */
+        HandView GetDealerHandView() const override {
+            dealer_buffer_.assign(1, GetDealerCard());
+            return HandView{dealer_buffer_.data(), 1};
+        }
+
+    private:
+        int win_point_;
+        mutable Hand hand_buffer_;    ///< Storage behind @ref GetHandView
+        mutable Hand dealer_buffer_;  ///< Storage behind @ref GetDealerHandView
+};
+
+#endif // ESAT_BLACKJACK_INTERFACES_ITABLE_ADAPTER_H
@@ -0,0 +1,364 @@
+#include "NewBJ/jaco_bench.h"
+#include "NewBJ/jaco_alloc.h"
+#include "NewBJ/jaco_game.h"
+#include "NewBJ/jaco_table.h"
+#include "NewBJ/jaco_player.h"
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  /**
+   * @brief Command line options of the benchmark.
+   */
+  struct BenchOptions {
+    jaco_rules::GameType mode = jaco_rules::GameType::CLASSIC;
+    int players = 4;              ///< Players seated at every table
+    std::uint64_t seed = 1;       ///< Master seed of every shoe
+    std::string json_path;        ///< JSON output file ("-" = stdout, empty = none)
+    long long alloc_rounds = 100000;  ///< Steady-state rounds of the allocation check
+    double alloc_budget = -1.0;   ///< Allowed allocations per round (negative = report only)
+    jaco_bench::Config bench;
+  };
+
+  /** @brief Tables prepared for cases that consume one round per operation. */
+  constexpr int kTables = 64;
+
+  /** @brief Bankroll that no benchmark batch can exhaust. */
+  constexpr int kBenchMoney = 1 << 30;
+
+  void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " [--mode classic|round|extreme] [--players N] [--seed N]"
+                 " [--warmup N] [--repetitions N] [--min-time MICROSECONDS]"
+                 " [--filter TEXT] [--json FILE|-]"
+                 " [--alloc-rounds N] [--alloc-budget ALLOCS_PER_ROUND]\n"
+              << "  The allocation check needs a build with JACO_ALLOC_ACCOUNTING=1;"
+                 " it exits with 2 when the budget is exceeded.\n";
+  }
+
+  bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    auto& bench = options.bench;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (i + 1 >= argc) {
+        return false;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--mode") {
+        if (!jaco_rules::ParseMode(value, options.mode)) return false;
+      } else if (arg == "--players") {
+        options.players = std::atoi(value.c_str());
+      } else if (arg == "--seed") {
+        options.seed = std::strtoull(value.c_str(), nullptr, 10);
+      } else if (arg == "--warmup") {
+        bench.warmup = std::atoi(value.c_str());
+      } else if (arg == "--repetitions") {
+        bench.repetitions = std::atoi(value.c_str());
+      } else if (arg == "--min-time") {
+        bench.min_repetition_ns = std::atoll(value.c_str()) * 1000;
+      } else if (arg == "--filter") {
+        bench.filter = value;
+      } else if (arg == "--json") {
+        options.json_path = value;
+      } else if (arg == "--alloc-rounds") {
+        options.alloc_rounds = std::atoll(value.c_str());
+      } else if (arg == "--alloc-budget") {
+        options.alloc_budget = std::atof(value.c_str());
+      } else {
+        return false;
+      }
+    }
+    return options.players >= 1 && options.players <= ITable::kMaxPlayers &&
+           bench.warmup >= 0 && bench.repetitions > 0 && options.alloc_rounds > 0;
+  }
+
+  std::vector<jaco_player> MakePlayers(const jaco_rules& rules, int count) {
+    std::vector<jaco_player> players;
+    players.reserve(ITable::kMaxPlayers);
+    for (int i = 0; i < count; ++i) {
+      players.emplace_back(i, rules);
+    }
+    return players;
+  }
+
+  /**
+   * @brief A seeded table with its own players.
+   */
+  struct BenchTable {
+    BenchTable(const jaco_rules& rules, int seats, std::uint64_t seed, std::uint64_t table_id)
+        : rules(rules), players(MakePlayers(rules, seats)), table(rules, players, seed, table_id) {}
+
+    /**
+     * @brief Starts a round and places the minimum bet on every seat.
+     */
+    void Deal() {
+      for (auto& player : players) {
+        player.player_money = kBenchMoney;
+      }
+      table.StartRound();
+      for (int i = 0; i < static_cast<int>(players.size()); ++i) {
+        table.PlayInitialBet(i, rules.MinimumInitialBet());
+      }
+    }
+
+    const jaco_rules& rules;
+    std::vector<jaco_player> players;
+    jaco_table table;
+  };
+
+  /**
+   * @brief A seeded game with its own players.
+   */
+  struct BenchGame {
+    BenchGame(const jaco_rules& rules, int seats, std::uint64_t seed)
+        : players(MakePlayers(rules, seats)), game(rules, players, seed) {}
+
+    void Refill() {
+      for (auto& player : players) {
+        player.player_money = kBenchMoney;
+      }
+    }
+
+    std::vector<jaco_player> players;
+    jaco_game game;
+  };
+
+  void RunShoeCases(jaco_bench& bench, const jaco_rules& rules, const BenchOptions& options) {
+    const auto nothing = [] {};
+
+    bench.Run("Cards::Cards()", 0, nothing, [](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        Cards shoe;
+        jaco_bench::DoNotOptimize(shoe.Deck.data());
+      }
+    });
+
+    const int decks = rules.NumberOfDecks();
+    bench.Run("Cards::Cards(decks, penetration)", 0, nothing, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        Cards shoe(decks, rules.Penetration());
+        jaco_bench::DoNotOptimize(shoe.Deck.data());
+      }
+    });
+
+    Cards shoe(decks, rules.Penetration());
+    shoe.SetSeed(options.seed, 0);
+    bench.Run("Cards::shuffleCards", 0, nothing, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        shoe.shuffleCards();
+        jaco_bench::DoNotOptimize(shoe.Deck.front());
+      }
+    });
+
+    // One shuffled shoe per repetition, dealt at most to its last card.
+    bench.Run("Cards::giveCard", static_cast<long long>(shoe.Deck.size()),
+              [&] { shoe.shuffleCards(); },
+              [&](long long n) {
+                for (long long i = 0; i < n; ++i) {
+                  const Cards::Card card = shoe.giveCard();
+                  jaco_bench::DoNotOptimize(card);
+                }
+              });
+  }
+
+  void RunPlayerCases(jaco_bench& bench, const jaco_rules& rules, const BenchOptions& options) {
+    BenchTable seats(rules, options.players, options.seed, 0);
+    seats.Deal();
+    const int count = options.players;
+    const auto nothing = [] {};
+
+    bench.Run("jaco_player::HandScore", 0, nothing, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        const int score = seats.players[i % count].HandScore(0);
+        jaco_bench::DoNotOptimize(score);
+      }
+    });
+
+    // Through the interfaces, as a third-party bot is called.
+    std::vector<IPlayer*> interfaces;
+    for (auto& player : seats.players) {
+      interfaces.push_back(&player);
+    }
+    const ITable& table = seats.table;
+    bench.Run("jaco_player::DecidePlayerAction (virtual)", 0, nothing, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        const int seat = static_cast<int>(i % count);
+        const ITable::Action action = interfaces[seat]->DecidePlayerAction(table, seat, 0);
+        jaco_bench::DoNotOptimize(action);
+      }
+    });
+
+    bench.Run("jaco_player::Decide (static)", 0, nothing, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        const int seat = static_cast<int>(i % count);
+        const ITable::Action action = seats.players[seat].Decide(seats.table, seat, 0);
+        jaco_bench::DoNotOptimize(action);
+      }
+    });
+  }
+
+  void RunTableCases(jaco_bench& bench, const jaco_rules& rules, const BenchOptions& options) {
+    std::vector<std::unique_ptr<BenchTable>> tables;
+    for (int i = 0; i < kTables; ++i) {
+      tables.push_back(std::make_unique<BenchTable>(rules, options.players, options.seed, i));
+    }
+    const int count = options.players;
+    const auto deal_all = [&] {
+      for (auto& seats : tables) {
+        seats->Deal();
+      }
+    };
+
+    // One hit on the first hand of every seat of every dealt table.
+    bench.Run("jaco_table::ApplyPlayerAction(Hit)", static_cast<long long>(kTables) * count,
+              deal_all, [&](long long n) {
+                for (long long i = 0; i < n; ++i) {
+                  const ITable::Result result = tables[i / count]->table.ApplyPlayerAction(
+                      static_cast<int>(i % count), 0, ITable::Action::Hit);
+                  jaco_bench::DoNotOptimize(result);
+                }
+              });
+
+    BenchTable& first = *tables.front();
+    bench.Run("jaco_table::StartRound", 0, [&] { first.Deal(); }, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        first.table.StartRound();
+        jaco_bench::DoNotOptimize(first.players.front());
+      }
+    });
+
+    bench.Run("jaco_table::FinishRound", kTables, deal_all, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        const ITable::RoundEndInfo info = tables[i]->table.FinishRound();
+        jaco_bench::DoNotOptimize(info);
+      }
+    });
+
+    // Same settlement into a reused buffer, as the game loop does it.
+    ITable::RoundResults results;
+    bench.Run("jaco_table::SettleRound", kTables, deal_all, [&](long long n) {
+      for (long long i = 0; i < n; ++i) {
+        tables[i]->table.SettleRound(results);
+        jaco_bench::DoNotOptimize(results);
+      }
+    });
+  }
+
+  void RunGameCases(jaco_bench& bench, const jaco_rules& rules, const BenchOptions& options) {
+    BenchGame played(rules, options.players, options.seed);
+    bench.Run("jaco_game::PlayGame (one round)", 0, [&] { played.Refill(); },
+              [&](long long n) {
+                for (long long i = 0; i < n; ++i) {
+                  played.game.PlayGame();
+                }
+                jaco_bench::DoNotOptimize(played.game.LastRound());
+              });
+
+    bench.Run("jaco_game::PlayRoundVirtual", 0, [&] { played.Refill(); },
+              [&](long long n) {
+                for (long long i = 0; i < n; ++i) {
+                  played.game.PlayRoundVirtual();
+                }
+                jaco_bench::DoNotOptimize(played.game.LastRound());
+              });
+  }
+
+  /** @brief Rounds played before counting, so every buffer has grown. */
+  constexpr long long kAllocWarmupRounds = 1000;
+
+  /**
+   * @brief Counts the allocations of steady-state PlayGame rounds.
+   *
+   * @param out Report stream (stderr when the JSON goes to stdout).
+   * @return false if @ref BenchOptions::alloc_budget is set and exceeded.
+   */
+  bool CheckAllocations(const jaco_rules& rules, const BenchOptions& options,
+                        std::ostream& out) {
+    BenchGame played(rules, options.players, options.seed);
+    played.Refill();
+    for (long long i = 0; i < kAllocWarmupRounds; ++i) {
+      played.game.PlayGame();
+    }
+    const jaco_alloc::Snapshot before = jaco_alloc::Collect();
+    for (long long i = 0; i < options.alloc_rounds; ++i) {
+      played.game.PlayGame();
+    }
+    const jaco_alloc::Snapshot counted = jaco_alloc::Collect().Since(before);
+
+    out << "\nAllocations over " << options.alloc_rounds
+              << " steady-state rounds:\n";
+    jaco_alloc::Report(out, counted, options.alloc_rounds);
+    if (options.alloc_budget < 0.0) {
+      return true;
+    }
+    const double per_round = static_cast<double>(counted.Allocations()) /
+                             static_cast<double>(options.alloc_rounds);
+    const bool within = per_round <= options.alloc_budget;
+    out << "Allocation budget: " << per_round << " per round (budget "
+              << options.alloc_budget << ") " << (within ? "OK" : "EXCEEDED") << "\n";
+    return within;
+  }
+
+}  // namespace
+
+/**
+ * @brief Entry point for the engine microbenchmarks.
+ *
+ * Times the shoe, player, table and round hot paths with the rules of one
+ * game mode and prints median and p99 nanoseconds per operation, optionally
+ * as JSON for comparing builds.
+ */
+int main(int argc, char** argv) {
+  BenchOptions options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  const jaco_rules rules(options.mode);
+  if (options.alloc_budget >= 0.0 && !jaco_alloc::kEnabled) {
+    std::cerr << "--alloc-budget needs a build with JACO_ALLOC_ACCOUNTING=1\n";
+    return 1;
+  }
+  jaco_bench bench(options.bench);
+  RunShoeCases(bench, rules, options);
+  RunPlayerCases(bench, rules, options);
+  RunTableCases(bench, rules, options);
+  RunGameCases(bench, rules, options);
+
+  std::ostringstream context;
+  context << "\"context\": {\"mode\": \"" << jaco_rules::ModeName(options.mode) << "\""
+          << ", \"players\": " << options.players
+          << ", \"seed\": " << options.seed
+          << ", \"warmup\": " << options.bench.warmup
+          << ", \"repetitions\": " << options.bench.repetitions
+          << ", \"min_repetition_ns\": " << options.bench.min_repetition_ns << "}";
+
+  if (options.json_path == "-") {
+    bench.WriteJson(std::cout, context.str());
+  } else {
+    bench.Report(std::cout);
+    if (!options.json_path.empty()) {
+      std::ofstream out(options.json_path);
+      bench.WriteJson(out, context.str());
+      if (!out) {
+        std::cerr << "Cannot write " << options.json_path << "\n";
+        return 1;
+      }
+    }
+  }
+
+  // Timings above are inflated by the counting allocator in such builds.
+  std::ostream& report = options.json_path == "-" ? std::cerr : std::cout;
+  if (jaco_alloc::kEnabled && !CheckAllocations(rules, options, report)) {
+    return 2;
+  }
+  return 0;
+}
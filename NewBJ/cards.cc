@@ -2,46 +2,189 @@
 #ifndef JACO_CARDS_CC
 #define JACO_CARDS_CC
 #include "NewBJ/cards.h"
+#include "NewBJ/jaco_log.h"
+#include "NewBJ/jaco_alloc.h"
 
 /**
  * @brief Constructs a full deck of 52 unique cards.
+ */
+Cards::Cards() : Cards(1, 100) {}
+
+/**
+ * @brief Constructs an ordered shoe of @p num_decks decks.
+ *
+ * The cut card is placed after @p penetration percent of the shoe. The shoe
+ * is left unshuffled; callers shuffle it before the first round.
+ */
+Cards::Cards(int num_decks, int penetration){
+    JACO_ALLOC_SCOPE(Deck);
+    if(num_decks < 1) num_decks = 1;
+    if(penetration < 1) penetration = 1;
+    if(penetration > 100) penetration = 100;
+    penetration_ = penetration;
+    num_decks_ = num_decks;
+    ResetOrder();
+}
+
+/**
+ * @brief Appends one deck of 52 unique cards.
  *
  * This implementation iterates through all suit and value combinations
  * and fills the Deck vector accordingly. The Value enum starts at 1,
  * therefore the inner loop uses (j+1) when constructing the card.
  */
-Cards::Cards(){
+void Cards::AddDeck(){
     for(int i=0; i < 4; ++i){       // Iterate through suits.
         for(int j=0; j < 13; ++j){  // Iterate through values.
             //J+1 because the enum starts at 1.
-            Card c = {static_cast<Suit>(i), static_cast<Value>(j+1)};
+            Card c = {static_cast<Value>(j+1), static_cast<Suit>(i)};
             Deck.push_back(c);
         }
     }
 }
 
 /**
- * @brief Shuffles the deck using a random Mersenne Twister engine.
+ * @brief Rebuilds the ordered shoe of @ref num_decks_ decks.
+ */
+void Cards::ResetOrder(){
+    Deck.clear();
+    // One allocation for the whole shoe instead of one per growth step.
+    Deck.reserve(static_cast<size_t>(num_decks_) * kCardsPerDeck);
+    for(int d=0; d < num_decks_; ++d){
+        AddDeck();
+    }
+    cut_card_ = static_cast<int>(Deck.size()) * penetration_ / 100;
+}
+
+/**
+ * @brief Unbiased Fisher-Yates shuffle of the cards from @p first onwards.
  *
- * Creates a random_device seed and passes it to std::mt19937,
- * then applies std::shuffle on the Deck container.
+ * Written out instead of std::shuffle so the permutation is identical on
+ * every standard library.
+ */
+void Cards::ShuffleRange(int first, jaco_rng& rng){
+    for(int i = static_cast<int>(Deck.size()) - 1; i > first; --i){
+        const int j = first + static_cast<int>(rng.Below(static_cast<std::uint32_t>(i - first + 1)));
+        std::swap(Deck[i], Deck[j]);
+    }
+}
+
+/**
+ * @brief Shuffles the ordered shoe with the stream of the current round
+ * and rewinds the dealing position.
  */
 void Cards::shuffleCards(){
-    std::random_device rd;
-    std::mt19937 gen(rd()); //Random seed
-    std::shuffle(Deck.begin(), Deck.end(), gen);
+    ResetOrder();
+    jaco_rng rng = jaco_rng::ForRound(seed_, table_id_, round_);
+    ShuffleRange(0, rng);
+    shuffle_round_ = round_;
+    discard_round_ = 0;
+    discard_start_ = 0;
+    discards_ = 0;
+    shuffle_intact_ = true;
+    next_card_ = 0;
+    round_start_ = 0;
+}
 
+void Cards::SetSeed(std::uint64_t seed, std::uint64_t table_id){
+    seed_ = seed;
+    table_id_ = table_id;
+    shuffle_intact_ = false;
 }
 
 /**
- * @brief Prints all cards in the deck to standard output.
+ * @brief Advances the round, reshuffles at the cut card and remembers where
+ * the round starts.
+ */
+void Cards::BeginRound(){
+    ++round_;
+    if(NeedsShuffle()){
+        shuffleCards();
+    }
+    round_start_ = next_card_;
+    round_state_.round = round_;
+    round_state_.shuffle_round = shuffle_round_;
+    round_state_.discard_round = discard_round_;
+    round_state_.position = next_card_;
+    round_state_.discard_start = discard_start_;
+    round_state_.restorable = discards_ <= 1;
+}
+
+/**
+ * @brief Replays the recorded shuffles only when needed, then seeks.
+ */
+void Cards::Restore(const State& state){
+    if(!shuffle_intact_ || shuffle_round_ != state.shuffle_round ||
+       discard_round_ != state.discard_round){
+        round_ = state.shuffle_round;
+        shuffleCards();
+        if(state.discard_round != 0){
+            // The shoe ran dry at the end of the deck during discard_round.
+            round_ = state.discard_round;
+            round_start_ = state.discard_start;
+            next_card_ = static_cast<int>(Deck.size());
+            ReshuffleDiscards();
+        }
+    }
+    round_ = state.round - 1;
+    int position = state.position;
+    if(position < 0) position = 0;
+    if(position > static_cast<int>(Deck.size())) position = static_cast<int>(Deck.size());
+    next_card_ = position;
+    round_start_ = position;
+}
+
+/**
+ * @brief Takes over the cards and counters of @p source, one round back.
+ */
+void Cards::Arrange(const Cards& source){
+    *this = source;  // Same deck size, so the storage is reused.
+    round_ = source.round_ - 1;
+    next_card_ = source.round_start_;
+    round_start_ = source.round_start_;
+}
+
+/**
+ * @brief Reshuffles the discards behind the cards of the current round.
+ *
+ * If every card of the shoe is in play, one more deck is added so that
+ * dealing can continue.
+ */
+void Cards::ReshuffleDiscards(){
+    discard_round_ = round_;
+    discard_start_ = round_start_;
+    ++discards_;
+    // Keep the cards in play at the front of the shoe.
+    std::rotate(Deck.begin(), Deck.begin() + round_start_, Deck.begin() + next_card_);
+    const int in_play = next_card_ - round_start_;
+    if(in_play >= static_cast<int>(Deck.size())){
+        AddDeck();
+        cut_card_ = static_cast<int>(Deck.size()) * penetration_ / 100;
+    }
+    // Second half of the round's stream, disjoint from the shoe shuffle.
+    jaco_rng rng = jaco_rng::ForRound(seed_, table_id_, round_);
+    rng.Seek(1ull << 32);
+    ShuffleRange(in_play, rng);
+    round_start_ = 0;
+    next_card_ = in_play;
+    // A second reshuffle depends on the first one's timing as well.
+    shuffle_intact_ = discards_ == 1;
+}
+
+/**
+ * @brief Writes the cards still to be dealt to the log (Info level).
  *
  * Each card is displayed as "<value> of <suit>" using
  * Cards::PrintFig() and Cards::PrintSuit().
  */
 void Cards::showCards() const {
-    for(const auto c : Deck){
-        std::cout << PrintFig(c.fig) << " of " << PrintSuit(c.suit) << std::endl;
+    if(!jaco_log::Enabled(jaco_log::Level::Info)){
+        return;
+    }
+    std::ostream& out = jaco_log::Stream();
+    for(size_t i = next_card_; i < Deck.size(); ++i){
+        const auto c = Deck[i];
+        out << PrintFig(c.value_) << " of " << PrintSuit(c.suit_) << "\n";
     }
 }
 
@@ -53,10 +196,11 @@ void Cards::showCards() const {
  */
 std::string Cards::PrintSuit(Suit s){
     switch(s){
-        case Suit::Clubs: return "Clubs"; break;
-        case Suit::Diamons: return "Diamonds"; break;
-        case Suit::Hearts: return "Hearts"; break;
-        case Suit::Spades: return "Spades"; break;
+        case Suit::CLUBS: return "Clubs"; break;
+        case Suit::DIAMONDS: return "Diamonds"; break;
+        case Suit::HEARTS: return "Hearts"; break;
+        case Suit::SPADES: return "Spades"; break;
+        default: break;
     }
     return "";
 }
@@ -69,43 +213,38 @@ std::string Cards::PrintSuit(Suit s){
  */
 std::string Cards::PrintFig(Value f){
     switch(f){
-        case Value::Ace: return "Ace"; break;
-        case Value::Two: return "Two"; break;
-        case Value::Three: return "Three"; break;
-        case Value::Four: return "Four"; break;
-        case Value::Five: return "Five"; break;
-        case Value::Six: return "Six"; break;
-        case Value::Seven: return "Seven"; break;
-        case Value::Eight: return "Eight"; break;
-        case Value::Nine: return "Nine"; break;
-        case Value::Ten: return "Ten"; break;
-        case Value::Jack : return "Jack"; break;
-        case Value::Queen: return "Queen"; break;
-        case Value::King: return "King"; break;
+        case Value::ACE: return "Ace"; break;
+        case Value::TWO: return "Two"; break;
+        case Value::THREE: return "Three"; break;
+        case Value::FOUR: return "Four"; break;
+        case Value::FIVE: return "Five"; break;
+        case Value::SIX: return "Six"; break;
+        case Value::SEVEN: return "Seven"; break;
+        case Value::EIGHT: return "Eight"; break;
+        case Value::NINE: return "Nine"; break;
+        case Value::TEN: return "Ten"; break;
+        case Value::JACK : return "Jack"; break;
+        case Value::QUEEN: return "Queen"; break;
+        case Value::KING: return "King"; break;
+        default: break;
     }
     return "";
 }
 
 /**
- * @brief Removes and returns the top card from the deck.
+ * @brief Returns the next card of the shoe and advances the dealing position.
  *
- * This implementation takes the last card in the Deck vector (LIFO)
- * and removes it before returning it. If the deck is empty, a default
- * Card is returned and a warning is printed.
+ * When the shoe is exhausted mid-round the discards are reshuffled first
+ * (see @ref ReshuffleDiscards), so a default Card{} is never returned.
  *
- * @return Card The dealt card, or an empty Card{} if deck is empty.
+ * @return Card The dealt card.
  */
 Cards::Card Cards::giveCard(){
-    if(!Deck.empty()){
-        //Take last element from deck
-        Card YourCard = Deck.back();
-        //Erase element
-        Deck.pop_back();
-        return YourCard;
-    }else {
-        std::cout << "No cards left in deck." << std::endl;
-        return Card{};
+    if(next_card_ >= static_cast<int>(Deck.size())){
+        JACO_LOG(Info) << "No cards left in shoe, reshuffling discards.\n";
+        ReshuffleDiscards();
     }
+    return Deck[next_card_++];
 }
 
 #endif JACO_CARDS_CC
\ No newline at end of file
@@ -1,65 +1,95 @@
 #pragma once
 #ifndef JACO_CARDS_H
 #define JACO_CARDS_H
+#include <algorithm>
 #include <vector>
 #include <string>
-#include <random>
+#include <cstdint>
 #include <iostream>
+#include "Interface/itable.h"
+#include "NewBJ/jaco_rng.h"
 
 /**
  * @class Cards
- * @brief Represents a standard deck of playing cards and provides card utility functions.
+ * @brief Represents a shoe of one or more standard decks and provides card utility functions.
  *
- * This class manages a deck of 52 cards, allows shuffling, dealing,
- * printing card suits and values, and accessing card information.
+ * This class manages a persistent shoe of N x 52 cards, allows shuffling,
+ * dealing, printing card suits and values, and accessing card information.
+ * Dealt cards stay in @ref Deck behind the dealing position, so the shoe is
+ * only reshuffled when the cut card is reached (see @ref BeginRound).
+ *
+ * Shuffles are driven by @ref jaco_rng: every full shuffle starts from the
+ * ordered shoe and uses the stream of (seed, table id, round), so the shoe
+ * of any round can be rebuilt with @ref Restore.
  */
 class Cards {
     public:
 
         /**
-         * @enum Suit
-         * @brief Enumerates the four card suits.
+         * @struct State
+         * @brief Everything needed to rebuild the shoe at the start of a round.
+         *
+         * Besides the last full shuffle, it records the reshuffle of the
+         * discards made when a round ran the shoe dry (see @ref giveCard).
          */
-        enum class Suit{
-            Clubs,      ///< Clubs
-            Diamons,    ///< Diamonds
-            Hearts,     ///< Hearts
-            Spades      ///< Spades
+        struct State {
+            std::uint64_t round = 0;          ///< Round number
+            std::uint64_t shuffle_round = 0;  ///< Round of the last full shuffle
+            std::uint64_t discard_round = 0;  ///< Round of the last discard reshuffle since then (0 = none)
+            int position = 0;                 ///< Dealing position at the start of the round
+            int discard_start = 0;            ///< First card of @ref discard_round when the shoe ran dry
+            bool restorable = true;           ///< False after more than one discard reshuffle
         };
 
         /**
-         * @enum Value
-         * @brief Enumerates card face values.
+         * @brief Card suits, shared with the table interface.
+         */
+        using Suit = ITable::Suit;
+
+        /**
+         * @brief Card face values, shared with the table interface.
          *
          * Values follow Blackjack conventions:
          * - Ace is counted as 1 (can represent 11 in gameplay logic)
          * - Jack, Queen, and King map to 10 for Blackjack scoring
          */
-        enum class Value{
-            Ace = 1,    ///< Ace (1 or 11).
-            Two, 
-            Three,
-            Four, 
-            Five,
-            Six,
-            Seven,
-            Eight,
-            Nine,
-            Ten,
-            Jack = 11,  ///< Jack -> worth 10.
-            Queen = 12, ///< Queen -> worth 10.
-            King = 13   ///< King -> worth 10.
-        };
+        using Value = ITable::Value;
 
         /**
-         * @struct Card
-         * @brief Represents a single playing card with suit and value.
+         * @brief One-byte card used by the shoe, the hands and the interface.
          */
-        struct Card{
-            Suit suit;  ///< Suit of the card.
-            Value fig;  ///< Face value of the card.
-        };
-        
+        using Card = ITable::Card;
+
+        /**
+         * @brief Number of distinct point ranks: Ace, 2..9 and the ten-valued cards.
+         */
+        static constexpr int kNumRanks = 10;
+
+        /**
+         * @brief Blackjack points of each value, with the ace counted as 1.
+         *
+         * Indexed by the 4-bit value field of a Card.
+         */
+        static constexpr int kPoints[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 0, 0};
+
+        /**
+         * @brief Point rank of each value: 0 for the ace, 1..8 for Two..Nine,
+         * 9 for every ten-valued card.
+         *
+         * Indexed by the 4-bit value field of a Card.
+         */
+        static constexpr int kRank[16] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 9, 9, 9, 0, 0};
+
+        /**
+         * @brief Gets the Blackjack points of a card (ace counted as 1).
+         */
+        static constexpr int Points(Card c){ return kPoints[static_cast<int>(c.value_)]; }
+
+        /**
+         * @brief Gets the point rank (0..9) of a card.
+         */
+        static constexpr int Rank(Card c){ return kRank[static_cast<int>(c.value_)]; }
+
         /**
          * @brief Constructs a full deck of 52 cards.
          *
@@ -69,23 +99,113 @@ class Cards {
         Cards();
 
         /**
-         * @brief Randomly shuffles the deck.
+         * @brief Constructs a shoe of several decks with a cut card.
+         *
+         * @param num_decks Number of 52-card decks in the shoe (at least 1).
+         * @param penetration Percentage of the shoe dealt before the cut card
+         *                    is reached and the shoe is reshuffled.
+         */
+        Cards(int num_decks, int penetration);
+
+        /**
+         * @brief Randomly shuffles the whole shoe and rewinds it.
          *
-         * Uses std::shuffle with a random engine to ensure an unbiased shuffle.
+         * Puts the shoe back in order and applies a Fisher-Yates shuffle driven
+         * by the stream of the current round, so the result only depends on
+         * (seed, table id, round).
          */
         void shuffleCards();
 
         /**
-         * @brief Prints all cards currently in the deck to stdout.
+         * @brief Sets the master seed and the stream used by this shoe.
+         *
+         * A new shoe uses seed 0 and table id 0 until this is called, so
+         * constructing one is cheap; callers wanting a different game every
+         * run pass @ref jaco_rng::RandomSeed (see main.cc).
+         *
+         * @param seed Master seed of the run.
+         * @param table_id Identifier of the table that owns the shoe.
+         */
+        void SetSeed(std::uint64_t seed, std::uint64_t table_id);
+
+        /**
+         * @brief Marks the start of a round.
+         *
+         * Advances the round number and reshuffles the whole shoe if the cut
+         * card was reached during the previous rounds; otherwise keeps dealing
+         * from the current position.
+         */
+        void BeginRound();
+
+        /**
+         * @brief Rebuilds the shoe as it was at the start of a recorded round.
+         *
+         * Replays the full shuffle and, if any, the reshuffle of the discards,
+         * unless the shoe already holds that arrangement. The next
+         * @ref BeginRound lands on @p state.
+         *
+         * @param state State returned by @ref RoundState for the round.
+         */
+        void Restore(const State& state);
+
+        /**
+         * @brief Gets the state of the shoe at the start of the current round.
+         */
+        const State& RoundState() const { return round_state_; }
+
+        /**
+         * @brief Copies another shoe as it was just before its current round began.
+         *
+         * The next @ref BeginRound lands on the same round and dealing
+         * position as @p source without shuffling, so several tables can deal
+         * one round from a single shuffle (common random numbers).
+         *
+         * @param source Shoe on which @ref BeginRound has just been called.
+         */
+        void Arrange(const Cards& source);
+
+        /** @brief Gets the master seed of the shoe. */
+        std::uint64_t GetSeed() const { return seed_; }
+
+        /** @brief Gets the table id used as stream identifier. */
+        std::uint64_t TableId() const { return table_id_; }
+
+        /** @brief Gets the current round number (0 before the first round). */
+        std::uint64_t Round() const { return round_; }
+
+        /** @brief Gets the round in which the shoe was last shuffled. */
+        std::uint64_t ShuffleRound() const { return shuffle_round_; }
+
+        /** @brief Gets the index of the next card to deal. */
+        int Position() const { return next_card_; }
+
+        /** @brief Gets the dealing position at the start of the current round. */
+        int RoundStart() const { return round_start_; }
+
+        /**
+         * @brief Checks whether the cut card has been reached.
+         * @return true if the shoe must be reshuffled before the next round.
+         */
+        bool NeedsShuffle() const { return next_card_ >= cut_card_; }
+
+        /**
+         * @brief Gets the number of cards that can still be dealt before the shoe runs out.
+         */
+        int CardsLeft() const { return static_cast<int>(Deck.size()) - next_card_; }
+
+        /**
+         * @brief Writes the cards still to be dealt to the game log (see @ref jaco_log).
          *
          * Useful for debugging or visual verification of deck contents.
          */
         void showCards() const;
 
         /**
-         * @brief Deals the top card from the deck.
+         * @brief Deals the next card from the shoe.
          *
-         * Removes the first card in @ref Deck and returns it.
+         * If the shoe runs out in the middle of a round, the discards of the
+         * previous rounds are reshuffled behind the cards still in play, so a
+         * valid card is always returned.
          *
          * @return Card The dealt card.
          */
@@ -108,10 +228,10 @@ class Cards {
         static std::string PrintFig(Value f);
 
         /**
-         * @brief Container storing the current deck of cards.
+         * @brief Container storing the whole shoe.
          *
-         * Represents the full card set, possibly altered by shuffling
-         * or dealing operations.
+         * Cards before the dealing position have already been dealt; cards
+         * from it onwards are still to come.
          */
         std::vector<Card> Deck;
 
@@ -120,6 +240,71 @@ class Cards {
          * @brief Number of cards in a standard deck.
          */
         static const int kCardsPerDeck = 52; 
+
+        /**
+         * @brief Appends one ordered 52-card deck to @ref Deck.
+         */
+        void AddDeck();
+
+        /**
+         * @brief Puts every card of the shoe back in order.
+         */
+        void ResetOrder();
+
+        /**
+         * @brief Fisher-Yates shuffle of Deck[first, end) driven by @p rng.
+         */
+        void ShuffleRange(int first, jaco_rng& rng);
+
+        /**
+         * @brief Reshuffles the discards when the shoe runs out mid-round.
+         *
+         * Moves the cards dealt in the current round to the front of the shoe
+         * and shuffles every earlier discard behind them.
+         */
+        void ReshuffleDiscards();
+
+        /** @brief Index of the next card to deal. */
+        int next_card_ = 0;
+
+        /** @brief Index of the first card dealt in the current round. */
+        int round_start_ = 0;
+
+        /** @brief Dealing position at which the shoe is reshuffled. */
+        int cut_card_ = 0;
+
+        /** @brief Percentage of the shoe dealt before the cut card. */
+        int penetration_ = 100;
+
+        /** @brief Number of decks in the shoe. */
+        int num_decks_ = 1;
+
+        /** @brief Master seed of the run (constant until @ref SetSeed). */
+        std::uint64_t seed_ = 0;
+
+        /** @brief Stream identifier of the owning table. */
+        std::uint64_t table_id_ = 0;
+
+        /** @brief Current round number. */
+        std::uint64_t round_ = 0;
+
+        /** @brief Round in which the shoe was last shuffled. */
+        std::uint64_t shuffle_round_ = 0;
+
+        /** @brief Round of the last discard reshuffle since the full shuffle (0 = none). */
+        std::uint64_t discard_round_ = 0;
+
+        /** @brief Start of @ref discard_round_ when the shoe ran dry. */
+        int discard_start_ = 0;
+
+        /** @brief Discard reshuffles since the last full shuffle. */
+        int discards_ = 0;
+
+        /** @brief Deck holds exactly the arrangement of (@ref shuffle_round_, @ref discard_round_) for the current seed. */
+        bool shuffle_intact_ = false;
+
+        /** @brief Snapshot taken by @ref BeginRound. */
+        State round_state_;
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "NewBJ/jaco_alloc.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace {
+
+  std::atomic<std::uint64_t> g_allocations[jaco_alloc::kCategories];
+  std::atomic<std::uint64_t> g_bytes[jaco_alloc::kCategories];
+
+#if JACO_ALLOC_ACCOUNTING
+  void* Allocate(std::size_t size) {
+    jaco_alloc::Record(size);
+    void* memory = std::malloc(size != 0 ? size : 1);
+    if (memory == nullptr) {
+      throw std::bad_alloc();
+    }
+    return memory;
+  }
+#endif
+
+}  // namespace
+
+#if JACO_ALLOC_ACCOUNTING
+// Replacement global allocation functions; the aligned overloads keep the
+// library's implementation and are not counted (the engine has no
+// over-aligned types).
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  jaco_alloc::Record(size);
+  return std::malloc(size != 0 ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  jaco_alloc::Record(size);
+  return std::malloc(size != 0 ? size : 1);
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+#endif
+
+void jaco_alloc::Record(std::size_t bytes) {
+  const int category = static_cast<int>(current_);
+  g_allocations[category].fetch_add(1, std::memory_order_relaxed);
+  g_bytes[category].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+std::uint64_t jaco_alloc::Snapshot::Allocations() const {
+  std::uint64_t allocations = 0;
+  for (const auto& counter : categories) {
+    allocations += counter.allocations;
+  }
+  return allocations;
+}
+
+jaco_alloc::Snapshot jaco_alloc::Snapshot::Since(const Snapshot& before) const {
+  Snapshot delta;
+  for (int c = 0; c < kCategories; ++c) {
+    delta.categories[c].allocations =
+        categories[c].allocations - before.categories[c].allocations;
+    delta.categories[c].bytes = categories[c].bytes - before.categories[c].bytes;
+  }
+  return delta;
+}
+
+const char* jaco_alloc::CategoryName(Category category) {
+  switch (category) {
+    case Category::Other:
+      return "Other";
+    case Category::Deck:
+      return "Deck";
+    case Category::Hands:
+      return "Hands";
+    case Category::Interface:
+      return "Interface";
+    case Category::Results:
+      return "Results";
+    case Category::Logging:
+      return "Logging";
+    default:
+      return "Unknown";
+  }
+}
+
+jaco_alloc::Snapshot jaco_alloc::Collect() {
+  Snapshot snapshot;
+  for (int c = 0; c < kCategories; ++c) {
+    snapshot.categories[c].allocations = g_allocations[c].load(std::memory_order_relaxed);
+    snapshot.categories[c].bytes = g_bytes[c].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+void jaco_alloc::Report(std::ostream& out, const Snapshot& snapshot, long long rounds) {
+  if (!kEnabled) {
+    out << "Allocation accounting compiled out (build with JACO_ALLOC_ACCOUNTING=1)\n";
+    return;
+  }
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << std::left << std::setw(12) << "Category" << std::right << std::setw(14)
+      << "allocations" << std::setw(16) << "bytes" << std::setw(14) << "allocs/round"
+      << std::setw(14) << "bytes/round" << "\n";
+  out << std::fixed << std::setprecision(3);
+  const double per = rounds > 0 ? 1.0 / static_cast<double>(rounds) : 0.0;
+  Counter total;
+  for (int c = 0; c <= kCategories; ++c) {
+    const bool is_total = c == kCategories;
+    const Counter& counter = is_total ? total : snapshot.categories[c];
+    out << std::left << std::setw(12)
+        << (is_total ? "Total" : CategoryName(static_cast<Category>(c))) << std::right
+        << std::setw(14) << counter.allocations << std::setw(16) << counter.bytes
+        << std::setw(14) << static_cast<double>(counter.allocations) * per
+        << std::setw(14) << static_cast<double>(counter.bytes) * per << "\n";
+    if (!is_total) {
+      total.allocations += counter.allocations;
+      total.bytes += counter.bytes;
+    }
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
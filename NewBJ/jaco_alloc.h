@@ -0,0 +1,131 @@
+#pragma once
+#ifndef JACO_ALLOC_H
+#define JACO_ALLOC_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief Counts every heap allocation by category when nonzero (off by default).
+ *
+ * Replaces the global operator new, so it is meant for dedicated builds
+ * (premake5 --alloc-accounting); with 0 the scopes below expand to nothing.
+ */
+#ifndef JACO_ALLOC_ACCOUNTING
+#define JACO_ALLOC_ACCOUNTING 0
+#endif
+
+/**
+ * @class jaco_alloc
+ * @brief Heap allocations and bytes charged to the subsystem that made them.
+ *
+ * Code marks a region with @ref JACO_ALLOC_SCOPE; every operator new on the
+ * calling thread inside it is charged to that category, nested scopes
+ * winning. Allocations outside any scope are charged to Other. Counters are
+ * process-wide relaxed atomics, so @ref Collect can be read while worker
+ * threads run and two snapshots give the allocations of the rounds played
+ * in between.
+ */
+class jaco_alloc {
+public:
+    /**
+     * @enum Category
+     * @brief Subsystems allocations are charged to.
+     */
+    enum class Category : int {
+        Other = 0,   ///< Outside any scope (setup, simulator, history)
+        Deck,        ///< Shoe construction
+        Hands,       ///< Dealing hands and per-seat bookkeeping
+        Interface,   ///< Copies returned by the ITable interface
+        Results,     ///< Round settlement buffers and RoundEndInfo
+        Logging,     ///< Formatting and handing over log text
+        Count
+    };
+
+    static constexpr int kCategories = static_cast<int>(Category::Count);
+
+    /** @brief Checks whether accounting is compiled in. */
+    static constexpr bool kEnabled = JACO_ALLOC_ACCOUNTING != 0;
+
+    /**
+     * @struct Counter
+     * @brief Allocations and requested bytes of one category.
+     */
+    struct Counter {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    /**
+     * @struct Snapshot
+     * @brief Counters of every category at one point in time.
+     */
+    struct Snapshot {
+        std::array<Counter, kCategories> categories{};
+
+        /** @brief Allocations of every category. */
+        std::uint64_t Allocations() const;
+
+        /** @brief Counters accumulated since @p before. */
+        Snapshot Since(const Snapshot& before) const;
+    };
+
+    /**
+     * @class Scope
+     * @brief Charges the calling thread's allocations to one category until
+     * it goes out of scope.
+     */
+    class Scope {
+    public:
+        explicit Scope(Category category) : previous_(current_) { current_ = category; }
+        ~Scope() { current_ = previous_; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Category previous_;
+    };
+
+    static const char* CategoryName(Category category);
+
+    /**
+     * @brief Reads the counters (all zero when accounting is compiled out).
+     */
+    static Snapshot Collect();
+
+    /**
+     * @brief Prints each category's allocations and bytes, in total and per
+     * round when @p rounds is positive.
+     */
+    static void Report(std::ostream& out, const Snapshot& snapshot, long long rounds);
+
+    /**
+     * @brief Charges one allocation to the calling thread's category.
+     * Called by the replacement operator new.
+     */
+    static void Record(std::size_t bytes);
+
+private:
+    /** @brief Category of the calling thread's allocations. */
+    static inline thread_local Category current_ = Category::Other;
+};
+
+/**
+ * @brief Charges the allocations of the enclosing block, e.g.
+ * `JACO_ALLOC_SCOPE(Deck);`. Expands to nothing unless
+ * @ref JACO_ALLOC_ACCOUNTING is set.
+ */
+#if JACO_ALLOC_ACCOUNTING
+#define JACO_ALLOC_CONCAT_(a, b) a##b
+#define JACO_ALLOC_CONCAT(a, b) JACO_ALLOC_CONCAT_(a, b)
+#define JACO_ALLOC_SCOPE(category) \
+    const jaco_alloc::Scope JACO_ALLOC_CONCAT(jaco_alloc_scope_, __LINE__)(jaco_alloc::Category::category)
+/** @brief Same as @ref JACO_ALLOC_SCOPE for the rest of one full expression. */
+#define JACO_ALLOC_EXPR_SCOPE(category) jaco_alloc::Scope(jaco_alloc::Category::category)
+#else
+#define JACO_ALLOC_SCOPE(category) ((void)0)
+#define JACO_ALLOC_EXPR_SCOPE(category) ((void)0)
+#endif
+
+#endif // JACO_ALLOC_H
@@ -0,0 +1,103 @@
+#include "NewBJ/jaco_bench.h"
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+
+namespace {
+
+  /**
+   * @brief Nearest-rank percentile of sorted samples.
+   */
+  double Percentile(const std::vector<double>& sorted, double percent) {
+    if (sorted.empty()) {
+      return 0.0;
+    }
+    const double rank = std::ceil(percent / 100.0 * static_cast<double>(sorted.size()));
+    const size_t index = static_cast<size_t>(std::max(rank, 1.0)) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+  }
+
+  /**
+   * @brief Writes @p text as a JSON string literal.
+   */
+  void WriteJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (const char c : text) {
+      if (c == '"' || c == '\\') {
+        out << '\\' << c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        out << ' ';
+      } else {
+        out << c;
+      }
+    }
+    out << '"';
+  }
+
+}  // namespace
+
+jaco_bench::Result jaco_bench::Summarize(const std::string& name, long long operations,
+                                         std::vector<double>& samples) {
+  Result result;
+  result.name = name;
+  result.operations = operations;
+  result.repetitions = static_cast<int>(samples.size());
+  if (samples.empty()) {
+    return result;
+  }
+  std::sort(samples.begin(), samples.end());
+  const size_t middle = samples.size() / 2;
+  result.median_ns = samples.size() % 2 != 0
+                         ? samples[middle]
+                         : (samples[middle - 1] + samples[middle]) / 2.0;
+  result.p99_ns = Percentile(samples, 99.0);
+  result.min_ns = samples.front();
+  result.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                   static_cast<double>(samples.size());
+  return result;
+}
+
+void jaco_bench::Report(std::ostream& out) const {
+  size_t width = 9;
+  for (const auto& result : results_) {
+    width = std::max(width, result.name.size());
+  }
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << std::left << std::setw(static_cast<int>(width)) << "Benchmark" << std::right
+      << std::setw(12) << "median ns" << std::setw(12) << "p99 ns"
+      << std::setw(12) << "min ns" << std::setw(10) << "ops/rep" << "\n";
+  out << std::fixed << std::setprecision(1);
+  for (const auto& result : results_) {
+    out << std::left << std::setw(static_cast<int>(width)) << result.name << std::right
+        << std::setw(12) << result.median_ns << std::setw(12) << result.p99_ns
+        << std::setw(12) << result.min_ns << std::setw(10) << result.operations << "\n";
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void jaco_bench::WriteJson(std::ostream& out, const std::string& context) const {
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << std::fixed << std::setprecision(3);
+  out << "{\n";
+  if (!context.empty()) {
+    out << "  " << context << ",\n";
+  }
+  out << "  \"benchmarks\": [";
+  for (size_t i = 0; i < results_.size(); ++i) {
+    const Result& result = results_[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    WriteJsonString(out, result.name);
+    out << ", \"operations\": " << result.operations
+        << ", \"repetitions\": " << result.repetitions
+        << ", \"median_ns\": " << result.median_ns
+        << ", \"p99_ns\": " << result.p99_ns
+        << ", \"min_ns\": " << result.min_ns
+        << ", \"mean_ns\": " << result.mean_ns << "}";
+  }
+  out << (results_.empty() ? "]\n" : "\n  ]\n") << "}\n";
+  out.flags(flags);
+  out.precision(precision);
+}
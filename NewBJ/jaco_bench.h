@@ -0,0 +1,137 @@
+#pragma once
+#ifndef JACO_BENCH_H
+#define JACO_BENCH_H
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class jaco_bench
+ * @brief Minimal repetition-based timer for the engine's hot paths.
+ *
+ * Each case is run as a series of timed repetitions. A repetition calls the
+ * case's body once with an operation count and is timed as a whole, so the
+ * clock overhead is spread over the batch; the per-operation time of every
+ * repetition is one sample. Untimed setup runs before each repetition, which
+ * lets a case prepare state its operations consume (a fresh shoe, rounds
+ * waiting to be settled). Warmup repetitions run first and size the batch so
+ * a repetition lasts at least @ref Config::min_repetition_ns.
+ *
+ * Only the standard library is used, so the benchmark builds anywhere the
+ * engine does.
+ */
+class jaco_bench {
+public:
+    /**
+     * @struct Config
+     * @brief Repetition counts and batch sizing.
+     */
+    struct Config {
+        int warmup = 20;                        ///< Untimed repetitions before measuring
+        int repetitions = 200;                  ///< Timed repetitions (samples)
+        long long min_repetition_ns = 200000;   ///< Target duration of one repetition
+        std::string filter;                     ///< Run only cases whose name contains it
+    };
+
+    /**
+     * @struct Result
+     * @brief Per-operation timings of one case, in nanoseconds.
+     */
+    struct Result {
+        std::string name;
+        long long operations = 0;   ///< Operations per repetition
+        int repetitions = 0;
+        double median_ns = 0.0;
+        double p99_ns = 0.0;
+        double min_ns = 0.0;
+        double mean_ns = 0.0;
+    };
+
+    explicit jaco_bench(const Config& config) : config_(config) {}
+
+    /**
+     * @brief Times one case and stores its result.
+     *
+     * @param name Case name, reported as is.
+     * @param max_operations Largest batch @p body can run after one
+     *        @p setup (0 = unbounded).
+     * @param setup Called untimed before every repetition.
+     * @param body Called with the operation count of the repetition.
+     * @return false if the case was skipped by the filter.
+     */
+    template <class Setup, class Body>
+    bool Run(const std::string& name, long long max_operations, Setup setup, Body body) {
+        if (!config_.filter.empty() && name.find(config_.filter) == std::string::npos) {
+            return false;
+        }
+        const long long cap = max_operations > 0 ? max_operations : kMaxOperations;
+
+        // Warmup doubles the batch until a repetition is long enough.
+        long long operations = 1;
+        for (int i = 0; i < config_.warmup || i == 0; ++i) {
+            setup();
+            const long long elapsed = Time(body, operations);
+            if (elapsed < config_.min_repetition_ns && operations < cap) {
+                operations = std::min(operations * 2, cap);
+            }
+        }
+
+        std::vector<double> samples;
+        samples.reserve(config_.repetitions);
+        for (int i = 0; i < config_.repetitions; ++i) {
+            setup();
+            samples.push_back(static_cast<double>(Time(body, operations)) /
+                              static_cast<double>(operations));
+        }
+        results_.push_back(Summarize(name, operations, samples));
+        return true;
+    }
+
+    /**
+     * @brief Keeps the compiler from discarding a value computed in a body.
+     */
+    template <class T>
+    static void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+        (void)*sink;
+#endif
+    }
+
+    const std::vector<Result>& Results() const { return results_; }
+
+    /**
+     * @brief Prints the results as an aligned table.
+     */
+    void Report(std::ostream& out) const;
+
+    /**
+     * @brief Writes the results and @p context (already formatted JSON
+     * members, may be empty) as one JSON object.
+     */
+    void WriteJson(std::ostream& out, const std::string& context) const;
+
+private:
+    /** @brief Upper bound of a batch for unbounded cases. */
+    static constexpr long long kMaxOperations = 1LL << 24;
+
+    template <class Body>
+    static long long Time(Body& body, long long operations) {
+        const auto start = std::chrono::steady_clock::now();
+        body(operations);
+        const auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    }
+
+    static Result Summarize(const std::string& name, long long operations,
+                            std::vector<double>& samples);
+
+    Config config_;
+    std::vector<Result> results_;
+};
+
+#endif // JACO_BENCH_H
@@ -0,0 +1,109 @@
+#include "NewBJ/jaco_chart_file.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+  constexpr char kChartMagic[4] = {'J', 'S', 'C', '1'};
+
+}  // namespace
+
+jaco_chart_file::~jaco_chart_file() { Close(); }
+
+bool jaco_chart_file::Write(const jaco_strategy_chart& chart, int win_point,
+                            const std::string& path) {
+  Header header;
+  std::memcpy(header.magic, kChartMagic, sizeof(header.magic));
+  header.classes = jaco_strategy_chart::kClasses;
+  header.totals = jaco_strategy_chart::kTotals;
+  header.upcards = jaco_strategy_chart::kUpcards;
+  header.win_point = static_cast<std::uint8_t>(win_point);
+  header.entries = jaco_strategy_chart::kEntries;
+  header.reserved = 0;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(chart.data()), jaco_strategy_chart::kEntries);
+  return static_cast<bool>(out);
+}
+
+/**
+ * @brief Maps the whole file and checks it against the compiled chart layout.
+ */
+bool jaco_chart_file::Open(const std::string& path) {
+  Close();
+#ifndef _WIN32
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                         PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  base_ = static_cast<const std::uint8_t*>(mapping);
+  size_ = static_cast<std::size_t>(info.st_size);
+#else
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  base_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  Header header;
+  if (size_ < sizeof(header)) {
+    Close();
+    return false;
+  }
+  std::memcpy(&header, base_, sizeof(header));
+  if (std::memcmp(header.magic, kChartMagic, sizeof(header.magic)) != 0 ||
+      header.classes != jaco_strategy_chart::kClasses ||
+      header.totals != jaco_strategy_chart::kTotals ||
+      header.upcards != jaco_strategy_chart::kUpcards ||
+      header.entries != jaco_strategy_chart::kEntries ||
+      size_ < sizeof(header) + header.entries) {
+    Close();
+    return false;
+  }
+  const std::uint8_t* entries = base_ + sizeof(header);
+  for (std::uint32_t i = 0; i < header.entries; ++i) {
+    if (entries[i] > static_cast<std::uint8_t>(ITable::Action::Split)) {
+      Close();
+      return false;
+    }
+  }
+  entries_ = entries;
+  win_point_ = header.win_point;
+  return true;
+}
+
+void jaco_chart_file::Close() {
+#ifndef _WIN32
+  if (base_ != nullptr) {
+    ::munmap(const_cast<std::uint8_t*>(base_), size_);
+  }
+#endif
+  buffer_.clear();
+  base_ = nullptr;
+  entries_ = nullptr;
+  size_ = 0;
+  win_point_ = 0;
+}
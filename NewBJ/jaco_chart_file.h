@@ -0,0 +1,93 @@
+#pragma once
+#ifndef JACO_CHART_FILE_H
+#define JACO_CHART_FILE_H
+#include "NewBJ/jaco_strategy_chart.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class jaco_chart_file
+ * @brief Read-only strategy chart backed by a memory-mapped file.
+ *
+ * The file is a 16-byte @ref Header followed by the chart entries exactly as
+ * laid out in memory (see @ref jaco_strategy_chart::data), so once mapped the
+ * entries are used in place and every process running the same chart shares
+ * the same physical pages. Platforms without mmap read the file instead.
+ *
+ * The object owns the mapping: pointers from @ref Entries stay valid until
+ * it is destroyed or reopened.
+ */
+class jaco_chart_file {
+public:
+    /**
+     * @struct Header
+     * @brief Fixed layout at the start of a chart file.
+     */
+    struct Header {
+        char magic[4];          ///< "JSC1"
+        std::uint8_t classes;   ///< jaco_strategy_chart::kClasses
+        std::uint8_t totals;    ///< jaco_strategy_chart::kTotals
+        std::uint8_t upcards;   ///< jaco_strategy_chart::kUpcards
+        std::uint8_t win_point; ///< Win point the chart was solved for
+        std::uint32_t entries;  ///< Number of entry bytes after the header
+        std::uint32_t reserved; ///< Zero
+    };
+    static_assert(sizeof(Header) == 16, "chart header layout");
+
+    jaco_chart_file() = default;
+    ~jaco_chart_file();
+    jaco_chart_file(const jaco_chart_file&) = delete;
+    jaco_chart_file& operator=(const jaco_chart_file&) = delete;
+
+    /**
+     * @brief Writes a chart in the file format read by @ref Open.
+     * @param chart Chart to write.
+     * @param win_point Win point the chart was built for.
+     * @param path Destination file.
+     * @return true on success.
+     */
+    static bool Write(const jaco_strategy_chart& chart, int win_point,
+                      const std::string& path);
+
+    /**
+     * @brief Maps a chart file, validating its header and every entry.
+     * @param path Chart file written by @ref Write.
+     * @return true if the chart is usable.
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Releases the mapping.
+     */
+    void Close();
+
+    /**
+     * @brief Gets the mapped entries (nullptr when nothing is open).
+     */
+    const std::uint8_t* Entries() const { return entries_; }
+
+    /**
+     * @brief Gets the win point recorded in the header.
+     */
+    int WinPoint() const { return win_point_; }
+
+private:
+    /** @brief Start of the mapping (or of @ref buffer_). */
+    const std::uint8_t* base_ = nullptr;
+
+    /** @brief Mapped size in bytes. */
+    std::size_t size_ = 0;
+
+    /** @brief First chart entry, right after the header. */
+    const std::uint8_t* entries_ = nullptr;
+
+    /** @brief Win point recorded in the header. */
+    int win_point_ = 0;
+
+    /** @brief File contents on platforms without mmap. */
+    std::vector<std::uint8_t> buffer_;
+};
+
+#endif // JACO_CHART_FILE_H
@@ -0,0 +1,191 @@
+#include "NewBJ/jaco_dealer_odds.h"
+#include <fstream>
+
+namespace {
+
+  /** @brief Magic number of a dealer odds cache file ("JDO1"). */
+  constexpr std::uint32_t kCacheMagic = 0x314F444Au;
+
+  /** @brief Bits per rank in the drawn multiset key. */
+  constexpr int kDrawnBits = 5;
+
+}  // namespace
+
+std::size_t jaco_dealer_odds::CacheKeyHash::operator()(const CacheKey& key) const {
+  // FNV-1a over the counts.
+  std::uint64_t hash = 0xCBF29CE484222325ull;
+  for (const auto count : key) {
+    hash = (hash ^ count) * 0x100000001B3ull;
+  }
+  return static_cast<std::size_t>(hash);
+}
+
+jaco_dealer_odds::jaco_dealer_odds(int win_point, int dealer_stop)
+    : win_point_(win_point < kMaxWinPoint ? win_point : kMaxWinPoint),
+      dealer_stop_(dealer_stop),
+      shoe_(),
+      remaining_(0) {}
+
+jaco_dealer_odds::Composition jaco_dealer_odds::FullShoe(int decks) {
+  Composition shoe;
+  shoe.fill(4 * decks);
+  // Ten, Jack, Queen and King share the last rank.
+  shoe[kNumRanks - 1] = 16 * decks;
+  return shoe;
+}
+
+/**
+ * @brief Looks the upcard up in the cache or runs the memoized recursion.
+ */
+const jaco_dealer_odds::Distribution& jaco_dealer_odds::Compute(
+    const Composition& shoe, int upcard_rank) {
+  CacheKey key;
+  for (int rank = 0; rank < kNumRanks; ++rank) {
+    key[rank] = static_cast<std::uint16_t>(shoe[rank]);
+  }
+  key[kNumRanks] = static_cast<std::uint16_t>(upcard_rank);
+  const auto cached = cache_.find(key);
+  if (cached != cache_.end()) {
+    return cached->second;
+  }
+
+  shoe_ = shoe;
+  remaining_ = 0;
+  for (const int count : shoe_) {
+    remaining_ += count;
+  }
+  memo_.clear();
+  const Distribution result =
+      Draw(RankPoints(upcard_rank), upcard_rank == 0 ? 1 : 0, 1, 0);
+  memo_.clear();
+  return cache_.emplace(key, result).first->second;
+}
+
+/**
+ * @brief Removes each upcard in turn and collects its distribution.
+ */
+jaco_dealer_odds::Table jaco_dealer_odds::ComputeAll(const Composition& shoe) {
+  Table table;
+  if (LoadTable(shoe, table)) {
+    return table;
+  }
+  for (int upcard = 0; upcard < kNumRanks; ++upcard) {
+    if (shoe[upcard] <= 0) {
+      table[upcard] = Distribution{};
+      continue;
+    }
+    Composition rest = shoe;
+    --rest[upcard];
+    table[upcard] = Compute(rest, upcard);
+  }
+  SaveTable(shoe, table);
+  return table;
+}
+
+/**
+ * @brief Dealer rule applied to one state, recursing over every next card.
+ *
+ * Terminal states are cheap and not memoized; drawing states are keyed by
+ * the drawn multiset, which together with the fixed upcard determines the
+ * totals, the card count and the cards left.
+ */
+const jaco_dealer_odds::Distribution& jaco_dealer_odds::Draw(
+    int hard_total, int aces, int cards, std::uint64_t drawn) {
+  static thread_local Distribution terminal;
+  const int score = jaco_best_total(hard_total, aces, win_point_);
+
+  if (cards == 2 && score == win_point_) {
+    terminal = Distribution{};
+    terminal.blackjack = 1.0;
+    return terminal;
+  }
+  if (score > win_point_) {
+    terminal = Distribution{};
+    terminal.bust = 1.0;
+    return terminal;
+  }
+  // The table also stops drawing when the dealer hand is full; a dry shoe
+  // would be refilled from the discards, which is not modelled here.
+  if (score >= dealer_stop_ || cards >= jaco_player::kMaxHandCards ||
+      remaining_ == 0) {
+    terminal = Distribution{};
+    terminal.total[score] = 1.0;
+    return terminal;
+  }
+
+  const auto found = memo_.find(drawn);
+  if (found != memo_.end()) {
+    return found->second;
+  }
+
+  Distribution result;
+  const double total_cards = static_cast<double>(remaining_);
+  for (int rank = 0; rank < kNumRanks; ++rank) {
+    const int shift = rank * kDrawnBits;
+    const int left = shoe_[rank] - static_cast<int>((drawn >> shift) & 31u);
+    if (left <= 0) {
+      continue;
+    }
+    const double p = left / total_cards;
+    --remaining_;
+    const Distribution& next =
+        Draw(hard_total + RankPoints(rank), aces + (rank == 0 ? 1 : 0),
+             cards + 1, drawn + (std::uint64_t(1) << shift));
+    ++remaining_;
+    for (int s = 0; s <= kMaxWinPoint; ++s) {
+      result.total[s] += p * next.total[s];
+    }
+    result.bust += p * next.bust;
+    result.blackjack += p * next.blackjack;
+  }
+  return memo_.emplace(drawn, result).first->second;
+}
+
+std::string jaco_dealer_odds::CachePath(const Composition& shoe) const {
+  std::string path = cache_directory_ + "/dealer_w" + std::to_string(win_point_) +
+                     "_s" + std::to_string(dealer_stop_) + "_c";
+  for (int rank = 0; rank < kNumRanks; ++rank) {
+    path += (rank == 0 ? "" : "-") + std::to_string(shoe[rank]);
+  }
+  return path + ".bin";
+}
+
+/**
+ * @brief Reads a table written by @ref SaveTable, checking rules and shoe.
+ */
+bool jaco_dealer_odds::LoadTable(const Composition& shoe, Table& table) const {
+  if (cache_directory_.empty()) {
+    return false;
+  }
+  std::ifstream in(CachePath(shoe), std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::uint32_t magic = 0;
+  std::int32_t header[2] = {0, 0};
+  Composition stored{};
+  in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  in.read(reinterpret_cast<char*>(stored.data()), sizeof(stored));
+  if (!in || magic != kCacheMagic || header[0] != win_point_ ||
+      header[1] != dealer_stop_ || stored != shoe) {
+    return false;
+  }
+  in.read(reinterpret_cast<char*>(table.data()), sizeof(Table));
+  return static_cast<bool>(in);
+}
+
+void jaco_dealer_odds::SaveTable(const Composition& shoe, const Table& table) const {
+  if (cache_directory_.empty()) {
+    return;
+  }
+  std::ofstream out(CachePath(shoe), std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return;
+  }
+  const std::int32_t header[2] = {win_point_, dealer_stop_};
+  out.write(reinterpret_cast<const char*>(&kCacheMagic), sizeof(kCacheMagic));
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(shoe.data()), sizeof(shoe));
+  out.write(reinterpret_cast<const char*>(table.data()), sizeof(Table));
+}
@@ -0,0 +1,179 @@
+#pragma once
+#ifndef JACO_DEALER_ODDS_H
+#define JACO_DEALER_ODDS_H
+#include "NewBJ/cards.h"
+#include "NewBJ/jaco_player.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class jaco_dealer_odds
+ * @brief Exact distribution of the dealer's final hand for a given shoe.
+ *
+ * Computes, for a dealer upcard and the composition of the undealt cards,
+ * the probability of every final outcome under the table's dealer rule:
+ * the dealer draws while the best total (see @ref jaco_best_total) is below
+ * the dealer stop and stands otherwise. A two-card total equal to the win
+ * point is reported as blackjack; the hole card is only drawn after the
+ * players act, so there is no peek.
+ *
+ * The recursion draws without replacement and is memoized on the multiset of
+ * cards drawn so far (5 bits per rank), which is all the state the dealer
+ * has once the upcard and the shoe are fixed. Finished distributions are
+ * cached per (composition, upcard) in memory and, when a directory is set
+ * with @ref SetCacheDirectory, on disk per (rules, composition).
+ *
+ * Instances are not thread-safe; give each thread its own.
+ */
+class jaco_dealer_odds {
+public:
+    /** @brief Number of point ranks (index 0 = ace, 9 = ten-valued cards, see @ref Cards::Rank). */
+    static constexpr int kNumRanks = Cards::kNumRanks;
+
+    /** @brief Highest win point the engine supports. */
+    static constexpr int kMaxWinPoint = 30;
+
+    /**
+     * @brief Number of undealt cards of each rank.
+     */
+    using Composition = std::array<int, kNumRanks>;
+
+    /**
+     * @struct Distribution
+     * @brief Probabilities of the dealer's final outcomes; they sum to one.
+     */
+    struct Distribution {
+        /**
+         * @brief Probability of standing on each score (blackjack excluded).
+         *
+         * Only the dealer stop up to the win point are reachable, unless the
+         * shoe runs out or the dealer hand is full.
+         */
+        std::array<double, kMaxWinPoint + 1> total{};
+        double bust = 0.0;       ///< Probability of going over the win point
+        double blackjack = 0.0;  ///< Probability of a two-card total equal to the win point
+    };
+
+    /**
+     * @brief Distributions for every upcard rank, indexed like @ref Composition.
+     */
+    using Table = std::array<Distribution, kNumRanks>;
+
+    /**
+     * @brief Creates an engine for an explicit win point and dealer stop.
+     * @param win_point Score needed to win (at most @ref kMaxWinPoint).
+     * @param dealer_stop Score at which the dealer stops drawing.
+     */
+    jaco_dealer_odds(int win_point, int dealer_stop);
+
+    /**
+     * @brief Creates an engine for a rule set.
+     * @param rules @ref jaco_rules or a static rule set.
+     */
+    template <class Rules>
+    explicit jaco_dealer_odds(const Rules& rules)
+        : jaco_dealer_odds(rules.GetWinPoint(), rules.DealerStop()) {}
+
+    /**
+     * @brief Composition of @p decks full decks.
+     */
+    static Composition FullShoe(int decks);
+
+    /**
+     * @brief Blackjack points of a rank, with the ace counted as 1.
+     */
+    static constexpr int RankPoints(int rank) { return rank == 0 ? 1 : rank + 1; }
+
+    /**
+     * @brief Final-outcome distribution for one upcard.
+     *
+     * @param shoe Undealt cards, the upcard already removed.
+     * @param upcard_rank Rank of the dealer's face-up card.
+     * @return const Distribution& Cached result, valid until @ref ClearCache.
+     */
+    const Distribution& Compute(const Composition& shoe, int upcard_rank);
+
+    /**
+     * @brief Final-outcome distributions for every possible upcard.
+     *
+     * Each upcard is removed from @p shoe before its distribution is
+     * computed; upcards with no card left in the shoe get an all-zero entry.
+     * Read from and written to the disk cache when one is set.
+     *
+     * @param shoe Undealt cards, upcard included.
+     * @return Table One distribution per upcard rank.
+     */
+    Table ComputeAll(const Composition& shoe);
+
+    /**
+     * @brief Enables the disk cache of @ref ComputeAll results.
+     * @param directory Existing directory for the cache files (empty disables it).
+     */
+    void SetCacheDirectory(const std::string& directory) { cache_directory_ = directory; }
+
+    /**
+     * @brief Drops every in-memory result.
+     */
+    void ClearCache() { cache_.clear(); }
+
+    /**
+     * @brief Gets the win point the engine was built for.
+     */
+    int WinPoint() const { return win_point_; }
+
+    /**
+     * @brief Gets the dealer stop the engine was built for.
+     */
+    int DealerStop() const { return dealer_stop_; }
+
+private:
+    /** @brief Composition counts followed by the upcard rank. */
+    using CacheKey = std::array<std::uint16_t, kNumRanks + 1>;
+
+    struct CacheKeyHash {
+        std::size_t operator()(const CacheKey& key) const;
+    };
+
+    /**
+     * @brief Distribution of the rest of the hand from one dealer state.
+     *
+     * @param hard_total Dealer total with aces counted as 1.
+     * @param aces Aces in the dealer hand.
+     * @param cards Cards in the dealer hand.
+     * @param drawn Multiset of cards drawn after the upcard, 5 bits per rank.
+     */
+    const Distribution& Draw(int hard_total, int aces, int cards, std::uint64_t drawn);
+
+    /**
+     * @brief Path of the disk cache file for a composition.
+     */
+    std::string CachePath(const Composition& shoe) const;
+
+    bool LoadTable(const Composition& shoe, Table& table) const;
+    void SaveTable(const Composition& shoe, const Table& table) const;
+
+    /** @brief Score needed to win. */
+    int win_point_;
+
+    /** @brief Score at which the dealer stops drawing. */
+    int dealer_stop_;
+
+    /** @brief Undealt cards during a @ref Compute call (upcard removed). */
+    Composition shoe_;
+
+    /** @brief Number of cards in @ref shoe_ minus the ones drawn so far. */
+    int remaining_;
+
+    /** @brief Memo of @ref Draw for the current call, keyed by drawn multiset. */
+    std::unordered_map<std::uint64_t, Distribution> memo_;
+
+    /** @brief Finished distributions per (composition, upcard). */
+    std::unordered_map<CacheKey, Distribution, CacheKeyHash> cache_;
+
+    /** @brief Directory of the disk cache (empty = disabled). */
+    std::string cache_directory_;
+};
+
+#endif // JACO_DEALER_ODDS_H
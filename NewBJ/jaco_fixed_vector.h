@@ -0,0 +1,113 @@
+#pragma once
+#ifndef JACO_FIXED_VECTOR_H
+#define JACO_FIXED_VECTOR_H
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @class jaco_fixed_vector
+ * @brief Vector-like container with a fixed capacity stored inline.
+ *
+ * Holds up to @p N elements inside the object itself, so filling, clearing
+ * and copying it never touch the heap. It mirrors the subset of the
+ * std::vector interface used by the engine; @ref push_back reports failure
+ * instead of growing when the container is full.
+ *
+ * @tparam T Element type (default constructible).
+ * @tparam N Maximum number of elements.
+ */
+template <typename T, int N>
+class jaco_fixed_vector {
+public:
+    static_assert(N > 0, "jaco_fixed_vector needs a positive capacity");
+
+    /// Smallest integer type able to hold the element count
+    using size_type = typename std::conditional<(N < 256), std::uint8_t, std::uint32_t>::type;
+
+    jaco_fixed_vector() = default;
+
+    /**
+     * @brief Creates @p count copies of @p value (clamped to the capacity).
+     */
+    jaco_fixed_vector(int count, const T& value) { assign(count, value); }
+
+    /**
+     * @brief Creates a container holding a copy of [first, last).
+     */
+    template <typename It>
+    jaco_fixed_vector(It first, It last) { assign(first, last); }
+
+    static constexpr int capacity() { return N; }
+    int size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == N; }
+
+    T* data() { return items_; }
+    const T* data() const { return items_; }
+    T* begin() { return items_; }
+    T* end() { return items_ + count_; }
+    const T* begin() const { return items_; }
+    const T* end() const { return items_ + count_; }
+
+    T& operator[](int index) { return items_[index]; }
+    const T& operator[](int index) const { return items_[index]; }
+    T& front() { return items_[0]; }
+    const T& front() const { return items_[0]; }
+    T& back() { return items_[count_ - 1]; }
+    const T& back() const { return items_[count_ - 1]; }
+
+    /**
+     * @brief Appends an element.
+     * @return false (and leaves the container unchanged) when it is full.
+     */
+    bool push_back(const T& value) {
+        if (count_ == N) {
+            return false;
+        }
+        items_[count_++] = value;
+        return true;
+    }
+
+    void pop_back() { --count_; }
+    void clear() { count_ = 0; }
+
+    /**
+     * @brief Replaces the contents with @p count copies of @p value.
+     */
+    void assign(int count, const T& value) {
+        count_ = 0;
+        resize(count, value);
+    }
+
+    /**
+     * @brief Replaces the contents with a copy of [first, last).
+     */
+    template <typename It>
+    void assign(It first, It last) {
+        count_ = 0;
+        for (; first != last && count_ < N; ++first) {
+            items_[count_++] = *first;
+        }
+    }
+
+    /**
+     * @brief Grows with copies of @p value or shrinks to @p count elements.
+     */
+    void resize(int count, const T& value) {
+        if (count > N) count = N;
+        if (count < 0) count = 0;
+        while (count_ < count) {
+            items_[count_++] = value;
+        }
+        count_ = static_cast<size_type>(count);
+    }
+
+private:
+    /** @brief Inline element storage. */
+    T items_[N] = {};
+
+    /** @brief Number of elements in use. */
+    size_type count_ = 0;
+};
+
+#endif // JACO_FIXED_VECTOR_H
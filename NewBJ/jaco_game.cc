@@ -1,7 +1,9 @@
 #include "NewBJ/jaco_game.h"
 #include "NewBJ/jaco_player.h"
+#include "NewBJ/jaco_log.h"
+#include "NewBJ/jaco_profile.h"
+#include "NewBJ/jaco_history_writer.h"
 #include <algorithm>
-#include <iostream>
 
 namespace {
 
@@ -23,14 +25,49 @@ namespace {
 
 }  // namespace
 
-jaco_game::jaco_game(const jaco_rules& rules, std::vector<jaco_player>& players)
-    : rules_(rules), players_(players), table_(rules_, players_) {}
+jaco_game::jaco_game(const jaco_rules& rules, std::vector<jaco_player>& players,
+                     std::uint64_t seed, std::uint64_t table_id)
+    : rules_(rules),
+      players_(players),
+      table_(rules_, players_, seed, table_id),
+      table_interface_(&table_),
+      seats_(),
+      last_round_(),
+      rounds_played_(0) {
+  seats_.reserve(players_.size());
+  for (auto& player : players_) {
+    seats_.push_back(&player);
+  }
+}
 
 /**
- * @brief Runs automatic game round using jaco_table and player decisions.
+ * @brief Runs one round compiled for the static rule set of the game mode.
  */
 void jaco_game::PlayGame() {
+  jaco_dispatch_rules(rules_, [this](const auto& rules) { PlayRound(rules); });
+}
+
+template <class Rules>
+void jaco_game::PlayRound(const Rules& rules) {
+  RunRound<true>(rules);
+}
+
+void jaco_game::PlayRoundVirtual() {
+  RunRound<false>(rules_);
+}
+
+/**
+ * @brief Runs automatic game round using jaco_table and player decisions.
+ * @param rules Rule set providing the win point and dealer stop.
+ */
+template <bool Devirtualized, class Rules>
+void jaco_game::RunRound(const Rules& rules) {
+  JACO_PROFILE_BEGIN();
   table_.StartRound();
+  if (recorder_ != nullptr) {
+    recorder_->BeginRound();
+  }
+  JACO_PROFILE_MARK(StartRound);
 
   // Place a minimum bet for each player if possible.
   for (int player_index = 0; player_index < static_cast<int>(players_.size());
@@ -39,11 +76,12 @@ void jaco_game::PlayGame() {
     const int bet = std::min(rules_.MinimumInitialBet(), player_money);
     if (bet <= 0 ||
         table_.PlayInitialBet(player_index, bet) != ITable::Result::Ok) {
-      std::cout << "Player " << player_index
-                << " cannot place an initial bet.\n";
+      JACO_LOG(Info) << "Player " << player_index
+                     << " cannot place an initial bet.\n";
       continue;
     }
   }
+  JACO_PROFILE_MARK(InitialBets);
 
   // Offer insurance if dealer shows an Ace.
   if (table_.GetDealerCard().value_ == ITable::Value::ACE) {
@@ -55,55 +93,92 @@ void jaco_game::PlayGame() {
       }
     }
   }
+  JACO_PROFILE_MARK(Insurance);
 
-  // Auto-play each player's hands: hit until soft threshold 17.
+  // Auto-play each player's hands with their strategy charts.
   for (int player_index = 0; player_index < static_cast<int>(players_.size());
        ++player_index) {
-    auto& player = players_.at(player_index);
-    const int hand_count = table_.GetNumberOfHands(player_index);
-    for (int hand = 0; hand < hand_count; ++hand) {
+    auto& player = players_[player_index];
+    // Hands created by splits are appended and played in turn.
+    for (int hand = 0; hand < table_.GetNumberOfHands(player_index); ++hand) {
       while (true) {
-        const auto action =
-            player.DecidePlayerAction(table_, player_index, hand);
-        if (table_.ApplyPlayerAction(player_index, hand, action) !=
-            ITable::Result::Ok) {
+        ITable::Action action;
+        ITable::Result result;
+        int score;
+        if constexpr (Devirtualized) {
+          action = player.Decide(table_, player_index, hand);
+          result = table_.ApplyAction(player_index, hand, action);
+          score = player.HandScore(hand, rules);
+        } else {
+          ITable& table = *table_interface_;
+          action = seats_[player_index]->DecidePlayerAction(table, player_index, hand);
+          result = table.ApplyPlayerAction(player_index, hand, action);
+          score = table.GetHandSummary(player_index, hand).score;
+        }
+        if (result != ITable::Result::Ok) {
           break;
         }
+        if (recorder_ != nullptr) {
+          recorder_->Action(player_index, hand, action);
+        }
         // Stop if standing or busted.
-        const int score = player.HandScore(hand);
         if (action == ITable::Action::Stand ||
-            score > rules_.GetWinPoint()) {
+            score > rules.GetWinPoint()) {
           break;
         }
       }
-      // Stand if done with hits
-      table_.ApplyPlayerAction(player_index, hand, ITable::Action::Stand);
+      // Standing is a no-op for the table; the virtual path still reports it.
+      if constexpr (!Devirtualized) {
+        table_interface_->ApplyPlayerAction(player_index, hand, ITable::Action::Stand);
+      }
     }
   }
 
-  std::cout << "\n------------ Round finished ------------\n";
-  const auto info = table_.FinishRound();
-  std::cout << "\n Dealer delta : " << info.croupier_money_delta <<
-            " | Dealer money: " << table_.DealerMoney()
-            << "\n";
-  
-  for (size_t i = 0; i < info.player_money_delta.size(); ++i) {
-    // Print player money changes
-      std::cout << "\n Player " << i << " money change: "
+  JACO_PROFILE_MARK(PlayerDecisions);
+
+  JACO_LOG(Info) << "\n------------ Round finished ------------\n";
+  // The table marks DealerDraw between drawing and paying out.
+  table_.SettleRound(last_round_, rules);
+  JACO_PROFILE_END(Settlement);
+  ++rounds_played_;
+  if (recorder_ != nullptr) {
+    recorder_->EndRound(table_.Shoe(), players_, last_round_);
+  }
+
+  if (jaco_log::Enabled(jaco_log::Level::Info)) {
+    const auto& info = last_round_;
+    std::ostream& out = jaco_log::Stream();
+    out << "\n Dealer delta : " << info.croupier_money_delta <<
+        " | Dealer money: " << table_.DealerMoney()
+        << "\n";
+
+    for (size_t i = 0; i < info.player_money_delta.size(); ++i) {
+      // Print player money changes
+      out << "\n Player " << i << " money change: "
           << info.player_money_delta[i] << "\n";
-      std::cout << "  Money: " << players_[i].player_money << "\n";
-    // Print hand cards
-    players_[i].ShowHand();
-    std::cout << "\n";
-    if (i < info.winners.size()) {
-      for (size_t hand = 0; hand < info.winners[i].size(); ++hand) {
-        std::cout << "   Hand " << hand << ": "
-                  << ResultToString(info.winners[i][hand]) << "\n";
+      out << "  Money: " << players_[i].player_money << "\n";
+      // Print hand cards
+      players_[i].ShowHand();
+      out << "\n";
+      if (i < info.hand_counts.size()) {
+        for (int hand = 0; hand < info.hand_counts[i]; ++hand) {
+          out << "   Hand " << hand << ": "
+              << ResultToString(info.Winner(static_cast<int>(i), hand))
+              << "\n";
+        }
       }
     }
   }
+  // One write per round instead of one flush per line.
+  jaco_log::Flush();
 }
 
+// Round loop compiled for the runtime rules and each built-in static rule set.
+template void jaco_game::PlayRound<jaco_rules>(const jaco_rules&);
+template void jaco_game::PlayRound<jaco_classic_rules>(const jaco_classic_rules&);
+template void jaco_game::PlayRound<jaco_round_rules>(const jaco_round_rules&);
+template void jaco_game::PlayRound<jaco_extreme_rules>(const jaco_extreme_rules&);
+
 bool jaco_game::IsGameOver() const{
     for (const auto& player : players_) {
         if (player.player_money >= rules_.MinimumInitialBet()) {
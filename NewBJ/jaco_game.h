@@ -5,16 +5,111 @@
 #include "NewBJ/jaco_table.h"
 #include <vector>
 
+class jaco_history_recorder;
+
 class jaco_game : public IGame {
 public:
-    jaco_game(const jaco_rules& rules, std::vector<jaco_player>& players);
+    /**
+     * @param seed Master seed of the table's shoe (see @ref jaco_table).
+     * @param table_id Identifier of the table within the run.
+     */
+    jaco_game(const jaco_rules& rules, std::vector<jaco_player>& players,
+              std::uint64_t seed = 0, std::uint64_t table_id = 0);
     void PlayGame() override;
     bool IsGameOver() const;
 
+    /**
+     * @brief Plays one round under an explicit rule set.
+     *
+     * @ref PlayGame dispatches to this once per round; long-running callers
+     * dispatch once with @ref jaco_dispatch_rules and call it directly so the
+     * whole round is compiled for constant thresholds. Players and table are
+     * used through their final concrete types, so the decide, apply and score
+     * steps are direct calls the compiler can inline. Instantiated in
+     * jaco_game.cc for jaco_rules and the built-in static rule sets.
+     *
+     * @param rules Static rule set or @ref jaco_rules.
+     */
+    template <class Rules>
+    void PlayRound(const Rules& rules);
+
+    /**
+     * @brief Plays one round through the IPlayer and ITable interfaces.
+     *
+     * Same round as @ref PlayRound with the runtime rules, but every decision
+     * and action is a virtual call, as it is for third-party bots. Kept as the
+     * reference for measuring the cost of dynamic dispatch.
+     */
+    void PlayRoundVirtual();
+
+    /**
+     * @brief Gets the settlement of the last round played.
+     *
+     * The buffer is reused by every round, so the reference is only valid
+     * until the next call to @ref PlayGame.
+     *
+     * @return Results written by the table at the end of the last round.
+     */
+    const ITable::RoundResults& LastRound() const { return last_round_; }
+
+    /**
+     * @brief Gets the number of rounds played since construction.
+     */
+    long long RoundsPlayed() const { return rounds_played_; }
+
+    /**
+     * @brief Makes the table's shoe reproducible.
+     * @param seed Master seed of the run.
+     * @param table_id Identifier of the table within the run.
+     */
+    void SetSeed(std::uint64_t seed, std::uint64_t table_id) { table_.SetSeed(seed, table_id); }
+
+    /**
+     * @brief Makes the next round deal from a copy of a shared shoe.
+     * @param shoe Shoe on which @ref Cards::BeginRound has just been called.
+     */
+    void LoadShoe(const Cards& shoe) { table_.LoadShoe(shoe); }
+
+    /**
+     * @brief Makes the next round replay a recorded one (see @ref jaco_table::RestoreShoe).
+     */
+    void RestoreShoe(std::uint64_t seed, std::uint64_t table_id, const Cards::State& state) {
+        table_.RestoreShoe(seed, table_id, state);
+    }
+
+    /**
+     * @brief Records every following round into a hand history.
+     * @param recorder Recorder owned by the calling thread (nullptr = off).
+     */
+    void SetRecorder(jaco_history_recorder* recorder) { recorder_ = recorder; }
+
+    /**
+     * @brief Gets the table the game is played on.
+     */
+    const jaco_table& Table() const { return table_; }
+
 private:
+    /**
+     * @brief Round loop shared by @ref PlayRound and @ref PlayRoundVirtual.
+     * @tparam Devirtualized Call the concrete types directly instead of the interfaces.
+     */
+    template <bool Devirtualized, class Rules>
+    void RunRound(const Rules& rules);
+
     const jaco_rules& rules_;
     std::vector<jaco_player>& players_;
     jaco_table table_;
+
+    /** @brief The table seen through its interface (virtual path). */
+    ITable* table_interface_;
+
+    /** @brief The players seen through their interface (virtual path). */
+    std::vector<IPlayer*> seats_;
+    ITable::RoundResults last_round_;
+    long long rounds_played_;
+
+    /** @brief Hand history of the rounds (nullptr = not recorded). */
+    jaco_history_recorder* recorder_ = nullptr;
 };
 
 #endif // JACO_GAME_H
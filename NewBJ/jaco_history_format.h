@@ -0,0 +1,140 @@
+#pragma once
+#ifndef JACO_HISTORY_FORMAT_H
+#define JACO_HISTORY_FORMAT_H
+#include "NewBJ/cards.h"
+#include "NewBJ/jaco_player.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct jaco_history_format
+ * @brief On-disk layout of a binary hand history (version 3).
+ *
+ * A history file is a 24-byte @ref FileHeader followed by one fixed-size
+ * record per round. Every record of a file has the same size, given by the
+ * seat count in the header (@ref RecordSize), so record @e i is found by
+ * arithmetic and the whole file can be used in place once mapped:
+ *
+ *     RoundHeader | SeatRecord x seats | card pool (kPoolCards bytes)
+ *
+ * Cards are stored once in the pool: the dealer's cards first, then each
+ * hand's cards in seat order, referenced by offset and count. Actions are
+ * packed two bits each (@ref ITable::Action). All sizes are multiples of 8,
+ * so every record is aligned when the file is mapped.
+ *
+ * The header also keeps the rules the shoes were dealt under (game mode,
+ * decks, penetration): a record can only be re-dealt with the same ones.
+ */
+struct jaco_history_format {
+    /** @brief First bytes of every history file of this version. */
+    static constexpr char kMagic[4] = {'J', 'H', 'H', '3'};
+
+    /** @brief Bytes of the card pool of a record. */
+    static constexpr int kPoolCards = 64;
+
+    /** @brief Actions stored per hand (the count keeps going past it). */
+    static constexpr int kActionsPerHand = 16;
+
+    /**
+     * @enum Flags
+     * @brief Bits of RoundHeader::flags.
+     */
+    enum Flags : std::uint8_t {
+        kCardsTruncated = 1,    ///< The card pool was full; later cards are missing
+        kActionsTruncated = 2,  ///< A hand took more than kActionsPerHand actions
+        kShoeNotRestorable = 4  ///< The shoe cannot be rebuilt (see Cards::State::restorable)
+    };
+
+    /**
+     * @struct FileHeader
+     * @brief Fixed layout at the start of a history file.
+     */
+    struct FileHeader {
+        char magic[4];             ///< @ref kMagic
+        std::uint16_t seats;       ///< Seats of every record
+        std::uint16_t hands;       ///< Hand slots per seat (jaco_player::kMaxHands)
+        std::uint32_t record_size; ///< Bytes per record (@ref RecordSize)
+        std::uint32_t pool_cards;  ///< kPoolCards
+        std::uint8_t mode;         ///< jaco_rules::GameType of the recording
+        std::uint8_t decks;        ///< Decks in the shoe
+        std::uint8_t penetration;  ///< Cut card position in percent
+        std::uint8_t reserved[5];  ///< Zero
+    };
+    static_assert(sizeof(FileHeader) == 24, "history file header layout");
+
+    /**
+     * @struct RoundHeader
+     * @brief Shoe and dealer state of one round.
+     */
+    struct RoundHeader {
+        std::uint64_t seed;          ///< Master seed of the shoe
+        std::uint64_t table_id;      ///< Table (session) id of the shoe
+        std::uint64_t round;         ///< Round number of the shoe
+        std::uint64_t shuffle_round; ///< Round in which the shoe was last shuffled
+        std::uint64_t discard_round; ///< Round of the last discard reshuffle since then (0 = none)
+        std::int32_t shoe_position;  ///< Dealing position at the start of the round
+        std::int32_t discard_start;  ///< Cards::State::discard_start
+        std::int32_t dealer_delta;   ///< RoundResults::croupier_money_delta
+        std::uint8_t seats;          ///< Seats in use
+        std::uint8_t dealer_count;   ///< Dealer cards at the start of the pool
+        std::uint8_t pool_used;      ///< Cards written to the pool
+        std::uint8_t flags;          ///< @ref Flags
+    };
+    static_assert(sizeof(RoundHeader) == 56, "history round header layout");
+
+    /**
+     * @struct HandRecord
+     * @brief One hand of a seat.
+     */
+    struct HandRecord {
+        std::int32_t bet;            ///< Stake of the hand, doubled if it doubled down
+        std::uint32_t actions;       ///< Two bits per action, first action lowest
+        std::uint8_t first_card;     ///< Offset of the hand's cards in the pool
+        std::uint8_t card_count;     ///< Cards of the hand
+        std::uint8_t action_count;   ///< Actions taken (may exceed kActionsPerHand)
+        std::uint8_t result;         ///< ITable::RoundEndInfo::BetResult
+    };
+    static_assert(sizeof(HandRecord) == 12, "history hand layout");
+
+    /**
+     * @struct SeatRecord
+     * @brief Bets and settlement of one player.
+     */
+    struct SeatRecord {
+        std::int32_t payout;         ///< RoundResults::player_money_delta
+        std::int32_t insurance;      ///< Insurance (safe) bet
+        std::int32_t money;          ///< Bankroll after settlement
+        std::uint8_t hand_count;     ///< Hands played, counting splits
+        std::uint8_t reserved[3];    ///< Zero
+        HandRecord hands[jaco_player::kMaxHands];
+    };
+    static_assert(sizeof(SeatRecord) == 64, "history seat layout");
+
+    /**
+     * @brief Bytes of one record with @p seats seats.
+     */
+    static constexpr std::size_t RecordSize(int seats) {
+        return sizeof(RoundHeader) + static_cast<std::size_t>(seats) * sizeof(SeatRecord) +
+               kPoolCards;
+    }
+
+    /**
+     * @brief Packs a card as value | suit << 4.
+     */
+    static std::uint8_t EncodeCard(const Cards::Card& card) {
+        return static_cast<std::uint8_t>(static_cast<std::uint8_t>(card.value_) |
+                                         static_cast<std::uint8_t>(card.suit_) << 4);
+    }
+
+    /**
+     * @brief Unpacks a card written by @ref EncodeCard.
+     */
+    static Cards::Card DecodeCard(std::uint8_t code) {
+        Cards::Card card;
+        card.value_ = static_cast<Cards::Value>(code & 0x0F);
+        card.suit_ = static_cast<Cards::Suit>(code >> 4);
+        return card;
+    }
+};
+
+#endif // JACO_HISTORY_FORMAT_H
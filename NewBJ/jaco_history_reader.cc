@@ -0,0 +1,96 @@
+#include "NewBJ/jaco_history_reader.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+jaco_history_reader::~jaco_history_reader() { Close(); }
+
+/**
+ * @brief Maps the whole file; records are only validated through the header.
+ */
+bool jaco_history_reader::Open(const std::string& path) {
+  Close();
+#ifndef _WIN32
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                         PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  base_ = static_cast<const std::uint8_t*>(mapping);
+  size_ = static_cast<std::size_t>(info.st_size);
+  // Records are normally read front to back.
+  ::madvise(mapping, size_, MADV_SEQUENTIAL);
+#else
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  base_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  jaco_history_format::FileHeader header;
+  if (size_ < sizeof(header)) {
+    Close();
+    return false;
+  }
+  std::memcpy(&header, base_, sizeof(header));
+  if (std::memcmp(header.magic, jaco_history_format::kMagic, sizeof(header.magic)) != 0 ||
+      header.seats < 1 || header.seats > ITable::kMaxPlayers ||
+      header.hands != jaco_player::kMaxHands ||
+      header.pool_cards != jaco_history_format::kPoolCards ||
+      header.record_size != jaco_history_format::RecordSize(header.seats) ||
+      header.mode > static_cast<std::uint8_t>(jaco_rules::GameType::EXTREME) ||
+      header.penetration < 1 || header.penetration > 100) {
+    Close();
+    return false;
+  }
+  const jaco_rules::GameType mode = static_cast<jaco_rules::GameType>(header.mode);
+  // The shoes can only be rebuilt if this build deals the same decks.
+  if (header.decks != jaco_rules(mode).NumberOfDecks()) {
+    Close();
+    return false;
+  }
+  records_ = base_ + sizeof(header);
+  record_size_ = header.record_size;
+  count_ = (size_ - sizeof(header)) / record_size_;
+  seats_ = header.seats;
+  mode_ = mode;
+  penetration_ = header.penetration;
+  return true;
+}
+
+void jaco_history_reader::Close() {
+#ifndef _WIN32
+  if (base_ != nullptr) {
+    ::munmap(const_cast<std::uint8_t*>(base_), size_);
+  }
+#endif
+  buffer_.clear();
+  base_ = nullptr;
+  records_ = nullptr;
+  size_ = 0;
+  record_size_ = 0;
+  count_ = 0;
+  seats_ = 0;
+  mode_ = jaco_rules::GameType::CLASSIC;
+  penetration_ = jaco_rules::kShoePenetration;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#ifndef JACO_HISTORY_READER_H
+#define JACO_HISTORY_READER_H
+#include "NewBJ/jaco_history_format.h"
+#include "NewBJ/jaco_rules.h"
+#include "Interface/itable.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class jaco_history_reader
+ * @brief Read-only hand history backed by a memory-mapped file.
+ *
+ * Records are read in place: @ref Round returns a view over the mapped
+ * bytes, so iterating a history copies nothing and only touches the pages it
+ * reads. A trailing partial record (a file still being written) is ignored.
+ * Platforms without mmap read the file instead.
+ *
+ * The object owns the mapping: views stay valid until it is destroyed or
+ * reopened.
+ */
+class jaco_history_reader {
+public:
+    /**
+     * @class RoundView
+     * @brief One record of the mapped file.
+     */
+    class RoundView {
+    public:
+        explicit RoundView(const std::uint8_t* record, std::size_t size)
+            : record_(record), size_(size) {}
+
+        /** @brief Gets the shoe and dealer part of the record. */
+        const jaco_history_format::RoundHeader& Header() const {
+            return *reinterpret_cast<const jaco_history_format::RoundHeader*>(record_);
+        }
+
+        /** @brief Gets one seat (below Header().seats). */
+        const jaco_history_format::SeatRecord& Seat(int seat) const {
+            return reinterpret_cast<const jaco_history_format::SeatRecord*>(
+                record_ + sizeof(jaco_history_format::RoundHeader))[seat];
+        }
+
+        /** @brief Gets a card of the pool (below Header().pool_used). */
+        Cards::Card PoolCard(int index) const {
+            return jaco_history_format::DecodeCard(
+                record_[size_ - jaco_history_format::kPoolCards + index]);
+        }
+
+        /** @brief Gets a dealer card (below Header().dealer_count). */
+        Cards::Card DealerCard(int index) const { return PoolCard(index); }
+
+        /** @brief Gets a card of a hand (below hand.card_count). */
+        Cards::Card HandCard(const jaco_history_format::HandRecord& hand, int index) const {
+            return PoolCard(hand.first_card + index);
+        }
+
+        /** @brief Gets an action of a hand (below min(action_count, kActionsPerHand)). */
+        static ITable::Action HandAction(const jaco_history_format::HandRecord& hand, int index) {
+            return static_cast<ITable::Action>((hand.actions >> (2 * index)) & 3u);
+        }
+
+    private:
+        const std::uint8_t* record_;
+        std::size_t size_;
+    };
+
+    jaco_history_reader() = default;
+    ~jaco_history_reader();
+    jaco_history_reader(const jaco_history_reader&) = delete;
+    jaco_history_reader& operator=(const jaco_history_reader&) = delete;
+
+    /**
+     * @brief Maps a history file and checks its header against this build.
+     * @param path File written by @ref jaco_history_writer.
+     * @return true if the records are usable.
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Releases the mapping.
+     */
+    void Close();
+
+    /** @brief Gets the number of complete records. */
+    std::size_t Count() const { return count_; }
+
+    /** @brief Gets the seats of every record. */
+    int Seats() const { return seats_; }
+
+    /** @brief Gets the game mode the history was recorded in. */
+    jaco_rules::GameType Mode() const { return mode_; }
+
+    /** @brief Gets the cut card position of the recorded shoes. */
+    int Penetration() const { return penetration_; }
+
+    /** @brief Gets record @p index (below @ref Count). */
+    RoundView Round(std::size_t index) const {
+        return RoundView(records_ + index * record_size_, record_size_);
+    }
+
+private:
+    /** @brief Start of the mapping (or of @ref buffer_). */
+    const std::uint8_t* base_ = nullptr;
+
+    /** @brief Mapped size in bytes. */
+    std::size_t size_ = 0;
+
+    /** @brief First record, right after the header. */
+    const std::uint8_t* records_ = nullptr;
+
+    std::size_t record_size_ = 0;
+    std::size_t count_ = 0;
+    int seats_ = 0;
+    jaco_rules::GameType mode_ = jaco_rules::GameType::CLASSIC;
+    int penetration_ = jaco_rules::kShoePenetration;
+
+    /** @brief File contents on platforms without mmap. */
+    std::vector<std::uint8_t> buffer_;
+};
+
+#endif // JACO_HISTORY_READER_H
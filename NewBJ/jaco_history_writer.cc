@@ -0,0 +1,190 @@
+#include "NewBJ/jaco_history_writer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+  using Format = jaco_history_format;
+
+}  // namespace
+
+jaco_history_writer::~jaco_history_writer() { Close(); }
+
+bool jaco_history_writer::Open(const std::string& path, int seats,
+                               const jaco_rules& rules) {
+  Close();
+  if (seats < 1 || seats > ITable::kMaxPlayers) {
+    return false;
+  }
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    return false;
+  }
+  Format::FileHeader header = {};
+  std::memcpy(header.magic, Format::kMagic, sizeof(header.magic));
+  header.seats = static_cast<std::uint16_t>(seats);
+  header.hands = jaco_player::kMaxHands;
+  header.record_size = static_cast<std::uint32_t>(Format::RecordSize(seats));
+  header.pool_cards = Format::kPoolCards;
+  header.mode = static_cast<std::uint8_t>(rules.GetGameType());
+  header.decks = static_cast<std::uint8_t>(rules.NumberOfDecks());
+  header.penetration = static_cast<std::uint8_t>(rules.Penetration());
+  out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!out_) {
+    out_.close();
+    return false;
+  }
+
+  seats_ = seats;
+  stop_ = false;
+  failed_ = false;
+  thread_ = std::thread(&jaco_history_writer::Run, this);
+  return true;
+}
+
+void jaco_history_writer::Submit(std::vector<std::uint8_t>&& batch) {
+  if (batch.empty()) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    drained_.wait(lock, [this] { return queue_.size() < kMaxPendingBatches; });
+    queue_.push_back(std::move(batch));
+  }
+  ready_.notify_one();
+}
+
+/**
+ * @brief Appends batches outside the lock so producers are never blocked by I/O.
+ */
+void jaco_history_writer::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    ready_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      break;
+    }
+    std::vector<std::uint8_t> batch = std::move(queue_.front());
+    queue_.pop_front();
+    drained_.notify_all();
+    lock.unlock();
+    out_.write(reinterpret_cast<const char*>(batch.data()),
+               static_cast<std::streamsize>(batch.size()));
+    const bool ok = static_cast<bool>(out_);
+    lock.lock();
+    failed_ = failed_ || !ok;
+  }
+}
+
+bool jaco_history_writer::Close() {
+  if (!thread_.joinable()) {
+    return !failed_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  ready_.notify_one();
+  thread_.join();
+  out_.close();
+  failed_ = failed_ || !out_;
+  return !failed_;
+}
+
+jaco_history_recorder::jaco_history_recorder(jaco_history_writer& writer,
+                                             int batch_records)
+    : writer_(writer),
+      record_size_(writer.RecordSize()),
+      batch_bytes_(record_size_ * static_cast<std::size_t>(std::max(batch_records, 1))) {
+  batch_.reserve(batch_bytes_);
+}
+
+jaco_history_recorder::~jaco_history_recorder() { Flush(); }
+
+void jaco_history_recorder::BeginRound() {
+  std::memset(actions_, 0, sizeof(actions_));
+  std::memset(action_counts_, 0, sizeof(action_counts_));
+}
+
+/**
+ * @brief Appends one zeroed record to the batch and fills it in place.
+ */
+void jaco_history_recorder::EndRound(const Cards& shoe,
+                                     const std::vector<jaco_player>& players,
+                                     const ITable::RoundResults& info) {
+  const std::size_t offset = batch_.size();
+  batch_.resize(offset + record_size_);
+  std::uint8_t* record = batch_.data() + offset;
+  std::uint8_t* pool = record + record_size_ - Format::kPoolCards;
+  const int seats = std::min(static_cast<int>(players.size()), writer_.Seats());
+
+  // Taken at the start of the round, before any mid-round discard reshuffle.
+  const Cards::State& state = shoe.RoundState();
+  Format::RoundHeader header = {};
+  header.seed = shoe.GetSeed();
+  header.table_id = shoe.TableId();
+  header.round = state.round;
+  header.shuffle_round = state.shuffle_round;
+  header.discard_round = state.discard_round;
+  header.shoe_position = state.position;
+  header.discard_start = state.discard_start;
+  if (!state.restorable) {
+    header.flags |= Format::kShoeNotRestorable;
+  }
+  header.dealer_delta = info.croupier_money_delta;
+  header.seats = static_cast<std::uint8_t>(seats);
+
+  int used = 0;
+  auto push_card = [&](const Cards::Card& card) {
+    if (used < Format::kPoolCards) {
+      pool[used++] = Format::EncodeCard(card);
+    } else {
+      header.flags |= Format::kCardsTruncated;
+    }
+  };
+  for (const auto& card : info.dealer_hand) {
+    push_card(card);
+  }
+  header.dealer_count = static_cast<std::uint8_t>(used);
+
+  for (int p = 0; p < seats; ++p) {
+    const jaco_player& player = players[p];
+    Format::SeatRecord seat = {};
+    seat.payout = info.player_money_delta[p];
+    seat.insurance = info.insurance_bets[p];
+    seat.money = player.player_money;
+    const int hands = std::min(info.hand_counts[p], jaco_player::kMaxHands);
+    seat.hand_count = static_cast<std::uint8_t>(hands);
+    for (int h = 0; h < hands; ++h) {
+      Format::HandRecord& hand = seat.hands[h];
+      hand.bet = info.hand_bets[p * info.hand_stride + h];
+      hand.actions = actions_[p][h];
+      hand.action_count = action_counts_[p][h];
+      if (hand.action_count > Format::kActionsPerHand) {
+        header.flags |= Format::kActionsTruncated;
+      }
+      hand.result = static_cast<std::uint8_t>(info.Winner(p, h));
+      hand.first_card = static_cast<std::uint8_t>(used);
+      for (const auto& card : player.PlayerHand[h].cards) {
+        push_card(card);
+      }
+      hand.card_count = static_cast<std::uint8_t>(used - hand.first_card);
+    }
+    std::memcpy(record + sizeof(header) + p * sizeof(seat), &seat, sizeof(seat));
+  }
+  header.pool_used = static_cast<std::uint8_t>(used);
+  std::memcpy(record, &header, sizeof(header));
+
+  if (batch_.size() + record_size_ > batch_bytes_) {
+    Flush();
+  }
+}
+
+void jaco_history_recorder::Flush() {
+  if (batch_.empty()) {
+    return;
+  }
+  writer_.Submit(std::move(batch_));
+  batch_.clear();
+  batch_.reserve(batch_bytes_);
+}
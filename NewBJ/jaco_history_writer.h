@@ -0,0 +1,149 @@
+#pragma once
+#ifndef JACO_HISTORY_WRITER_H
+#define JACO_HISTORY_WRITER_H
+#include "NewBJ/jaco_history_format.h"
+#include "NewBJ/jaco_rules.h"
+#include "Interface/itable.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class jaco_history_writer
+ * @brief Append-only hand history file fed by a background thread.
+ *
+ * Game threads never touch the file: each one fills batches of records
+ * through its own @ref jaco_history_recorder and hands complete batches over
+ * with @ref Submit. The writer thread appends them in arrival order, so
+ * records of different tables interleave; each record carries its table id
+ * and round number. Submitting blocks only when the disk falls behind by
+ * more than a few batches.
+ */
+class jaco_history_writer {
+public:
+    jaco_history_writer() = default;
+    ~jaco_history_writer();
+    jaco_history_writer(const jaco_history_writer&) = delete;
+    jaco_history_writer& operator=(const jaco_history_writer&) = delete;
+
+    /**
+     * @brief Creates the file, writes its header and starts the writer thread.
+     * @param path Destination file (truncated).
+     * @param seats Seats of every record.
+     * @param rules Rules every recorded shoe is dealt under.
+     * @return true on success.
+     */
+    bool Open(const std::string& path, int seats, const jaco_rules& rules);
+
+    /**
+     * @brief Queues a batch of whole records for appending.
+     * @param batch Records of @ref RecordSize bytes each.
+     */
+    void Submit(std::vector<std::uint8_t>&& batch);
+
+    /**
+     * @brief Writes every queued batch, stops the thread and closes the file.
+     * @return true if every write succeeded.
+     */
+    bool Close();
+
+    /** @brief Gets the seats of every record. */
+    int Seats() const { return seats_; }
+
+    /** @brief Gets the bytes of one record. */
+    std::size_t RecordSize() const { return jaco_history_format::RecordSize(seats_); }
+
+private:
+    /** @brief Batches queued before Submit waits for the disk. */
+    static constexpr std::size_t kMaxPendingBatches = 16;
+
+    /**
+     * @brief Writer loop: appends queued batches until stopped.
+     */
+    void Run();
+
+    std::ofstream out_;
+    int seats_ = 0;
+    std::mutex mutex_;
+    std::condition_variable ready_;    ///< Signals queued batches or stop
+    std::condition_variable drained_;  ///< Signals room in the queue
+    std::deque<std::vector<std::uint8_t>> queue_;
+    bool stop_ = false;
+    bool failed_ = false;
+    std::thread thread_;
+};
+
+/**
+ * @class jaco_history_recorder
+ * @brief Builds the records of one game thread into local batches.
+ *
+ * Attached to a @ref jaco_game with @ref jaco_game::SetRecorder, it collects
+ * the actions of the round as they are applied and serializes the round
+ * once it is settled. Records are written straight into the batch buffer,
+ * so recording allocates only once per batch.
+ */
+class jaco_history_recorder {
+public:
+    /**
+     * @brief Prepares a recorder for @p writer.
+     * @param writer File shared by every recorder.
+     * @param batch_records Records per batch handed to the writer.
+     */
+    explicit jaco_history_recorder(jaco_history_writer& writer, int batch_records = 1024);
+
+    /**
+     * @brief Submits the records not yet handed over.
+     */
+    ~jaco_history_recorder();
+
+    jaco_history_recorder(const jaco_history_recorder&) = delete;
+    jaco_history_recorder& operator=(const jaco_history_recorder&) = delete;
+
+    /**
+     * @brief Clears the action log at the start of a round.
+     */
+    void BeginRound();
+
+    /**
+     * @brief Logs an action the table accepted.
+     */
+    void Action(int player_index, int hand_index, ITable::Action action) {
+        std::uint8_t& count = action_counts_[player_index][hand_index];
+        if (count < jaco_history_format::kActionsPerHand) {
+            actions_[player_index][hand_index] |=
+                static_cast<std::uint32_t>(action) << (2 * count);
+        }
+        if (count < UINT8_MAX) {
+            ++count;
+        }
+    }
+
+    /**
+     * @brief Serializes the settled round.
+     * @param shoe Shoe of the table (seed, round, start position).
+     * @param players Seats of the table, with their hands still in place.
+     * @param info Settlement written by the table.
+     */
+    void EndRound(const Cards& shoe, const std::vector<jaco_player>& players,
+                  const ITable::RoundResults& info);
+
+    /**
+     * @brief Hands the current batch to the writer.
+     */
+    void Flush();
+
+private:
+    jaco_history_writer& writer_;
+    std::size_t record_size_;
+    std::size_t batch_bytes_;
+    std::vector<std::uint8_t> batch_;
+    std::uint32_t actions_[ITable::kMaxPlayers][jaco_player::kMaxHands] = {};
+    std::uint8_t action_counts_[ITable::kMaxPlayers][jaco_player::kMaxHands] = {};
+};
+
+#endif // JACO_HISTORY_WRITER_H
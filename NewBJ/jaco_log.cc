@@ -0,0 +1,128 @@
+#include "NewBJ/jaco_log.h"
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+  /**
+   * @brief Background thread that prints flushed buffers in arrival order.
+   */
+  class Writer {
+  public:
+    Writer() : thread_(&Writer::Run, this) {}
+
+    /**
+     * @brief Prints whatever is still queued and stops the thread.
+     */
+    ~Writer() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      ready_.notify_one();
+      thread_.join();
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /**
+     * @brief Queues @p text for printing.
+     */
+    void Post(const std::string& text) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ += text;
+      }
+      ready_.notify_one();
+    }
+
+    /**
+     * @brief Blocks until every queued text has been printed.
+     */
+    void Wait() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      idle_.wait(lock, [this] { return pending_.empty() && !writing_; });
+    }
+
+  private:
+    /**
+     * @brief Swaps out the queue and prints it with one write and one flush.
+     */
+    void Run() {
+      std::string batch;
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        ready_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+        if (pending_.empty()) {
+          break;
+        }
+        batch.swap(pending_);
+        writing_ = true;
+        lock.unlock();
+        std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        std::cout.flush();
+        batch.clear();
+        lock.lock();
+        writing_ = false;
+        idle_.notify_all();
+      }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable idle_;
+    std::string pending_;   ///< Text waiting to be printed
+    bool writing_ = false;  ///< A batch is being printed outside the lock
+    bool stop_ = false;
+    std::thread thread_;
+  };
+
+  Writer& GetWriter() {
+    static Writer writer;
+    return writer;
+  }
+
+  /**
+   * @brief One thread's pending log text, handed over when the thread exits.
+   */
+  struct ThreadBuffer {
+    std::ostringstream stream;
+
+    ~ThreadBuffer() { Hand(); }
+
+    void Hand() {
+      const std::string text = stream.str();
+      if (!text.empty()) {
+        GetWriter().Post(text);
+        stream.str(std::string());
+      }
+    }
+  };
+
+  ThreadBuffer& GetBuffer() {
+    thread_local ThreadBuffer buffer;
+    return buffer;
+  }
+
+}  // namespace
+
+std::ostream& jaco_log::Stream() {
+  return GetBuffer().stream;
+}
+
+void jaco_log::FlushBuffer() {
+  JACO_ALLOC_SCOPE(Logging);
+  GetBuffer().Hand();
+}
+
+void jaco_log::Sync() {
+  Flush();
+  if constexpr (kCompiledLevel != Level::Silent) {
+    GetWriter().Wait();
+  }
+}
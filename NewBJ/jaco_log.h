@@ -0,0 +1,120 @@
+#pragma once
+#ifndef JACO_LOG_H
+#define JACO_LOG_H
+#include "NewBJ/jaco_alloc.h"
+#include <atomic>
+#include <ostream>
+
+/**
+ * @brief Most detailed level compiled in (see @ref jaco_log::Level).
+ *
+ * Headless builds default to 0, which removes every log statement at compile
+ * time; other builds compile everything and filter at run time.
+ */
+#ifndef JACO_LOG_LEVEL
+#ifdef JACO_HEADLESS
+#define JACO_LOG_LEVEL 0
+#else
+#define JACO_LOG_LEVEL 3
+#endif
+#endif
+
+/**
+ * @class jaco_log
+ * @brief Levelled, buffered game log.
+ *
+ * Each thread formats into its own buffer, so logging threads never contend
+ * on a shared stream. @ref Flush hands the buffer to a background writer
+ * that prints it to standard output in one write; the game flushes once per
+ * round, so the console shows the same text as a direct std::cout without a
+ * flush per line.
+ *
+ * Statements are written with @ref JACO_LOG. A level above
+ * @ref JACO_LOG_LEVEL is a constant false condition and compiles to nothing;
+ * a level above @ref SetLevel costs one relaxed atomic load.
+ */
+class jaco_log {
+public:
+    /**
+     * @enum Level
+     * @brief Verbosity of a statement, from least to most detailed.
+     */
+    enum class Level : int {
+        Silent = 0,  ///< Nothing is written
+        Error = 1,   ///< Misuse of the engine API
+        Info = 2,    ///< Round by round game output
+        Debug = 3    ///< Engine internals
+    };
+
+    /** @brief Most detailed level compiled in. */
+    static constexpr Level kCompiledLevel = static_cast<Level>(JACO_LOG_LEVEL);
+
+    /**
+     * @brief Checks whether statements of @p level are compiled in.
+     */
+    static constexpr bool Compiled(Level level) { return level <= kCompiledLevel; }
+
+    /**
+     * @brief Checks whether statements of @p level are written.
+     */
+    static bool Enabled(Level level) {
+        return Compiled(level) &&
+               static_cast<int>(level) <= level_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the most detailed level written (Info by default).
+     */
+    static void SetLevel(Level level) {
+        level_.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the most detailed level written.
+     */
+    static Level GetLevel() { return static_cast<Level>(level_.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Gets the calling thread's buffer.
+     */
+    static std::ostream& Stream();
+
+    /**
+     * @brief Hands the calling thread's buffer to the writer.
+     *
+     * Compiles to nothing when logging is compiled out.
+     */
+    static void Flush() {
+        if constexpr (kCompiledLevel != Level::Silent) {
+            FlushBuffer();
+        }
+    }
+
+    /**
+     * @brief Flushes the calling thread and waits until the writer is idle.
+     *
+     * Call before reading from standard input so prompts appear in order.
+     */
+    static void Sync();
+
+private:
+    /** @brief Moves the calling thread's buffer to the writer's queue. */
+    static void FlushBuffer();
+
+    /** @brief Most detailed level written. */
+    static inline std::atomic<int> level_{static_cast<int>(Level::Info)};
+};
+
+/**
+ * @brief Starts a log statement of the given level, e.g.
+ * `JACO_LOG(Info) << "Player " << i << "\n";`.
+ *
+ * The stream expression is not evaluated when the level is disabled. Its
+ * allocations are charged to jaco_alloc's Logging category.
+ */
+#define JACO_LOG(level)                                   \
+    if (!jaco_log::Enabled(jaco_log::Level::level)) {     \
+    } else                                                \
+        JACO_ALLOC_EXPR_SCOPE(Logging), jaco_log::Stream()
+
+#endif // JACO_LOG_H
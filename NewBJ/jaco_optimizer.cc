@@ -0,0 +1,129 @@
+#include "NewBJ/jaco_optimizer.h"
+#include "NewBJ/jaco_rng.h"
+#include <chrono>
+#include <vector>
+
+namespace {
+
+  using HandClass = jaco_strategy_chart::HandClass;
+
+  /** @brief Stream of the master seed used to draw mutations. */
+  constexpr std::uint64_t kMutationStream = 0x6F7074ull;  // "opt"
+
+  /** @brief Stream of the master seed used to draw common seeds. */
+  constexpr std::uint64_t kSeedStream = 0x637270ull;  // "crn"
+
+  /**
+   * @brief A chart row that a hand can actually reach.
+   */
+  struct Cell {
+    HandClass hand_class;
+    int total;
+  };
+
+  /**
+   * @brief Rows worth mutating under a win point: hard 4 and up, soft 12 and
+   * up, and every pair.
+   */
+  std::vector<Cell> ReachableRows(int win_point) {
+    std::vector<Cell> rows;
+    for (int total = 4; total <= win_point; ++total) {
+      rows.push_back({HandClass::Hard, total});
+    }
+    for (int total = 12; total <= win_point; ++total) {
+      rows.push_back({HandClass::Soft, total});
+    }
+    for (int rank = 0; rank < Cards::kNumRanks; ++rank) {
+      rows.push_back({HandClass::Pair, rank});
+    }
+    return rows;
+  }
+
+}  // namespace
+
+jaco_optimizer::jaco_optimizer(const Config& config) : config_(config) {
+  if (config_.seed == 0) {
+    config_.seed = jaco_rng::RandomSeed();
+  }
+}
+
+jaco_simulator::Results jaco_optimizer::Evaluate(const jaco_strategy_chart& incumbent,
+                                                 const jaco_strategy_chart& challenger,
+                                                 std::uint64_t seed,
+                                                 long long sessions) const {
+  jaco_simulator::Config sim;
+  sim.mode = config_.mode;
+  sim.sessions = sessions;
+  sim.rounds_per_session = config_.rounds_per_session;
+  sim.players = config_.players;
+  sim.threads = config_.threads;
+  sim.penetration = config_.penetration;
+  sim.seed = seed;
+  sim.compare = {incumbent.data(), challenger.data()};
+  jaco_simulator simulator(sim);
+  return simulator.Run();
+}
+
+/**
+ * @brief First-improvement hill climbing on single cells, each candidate
+ * paired with the incumbent on the same shoes.
+ */
+jaco_optimizer::Report jaco_optimizer::Run(const jaco_strategy_chart& start) {
+  const auto begin = std::chrono::steady_clock::now();
+  const jaco_rules rules(config_.mode);
+  const std::vector<Cell> rows = ReachableRows(rules.GetWinPoint());
+  jaco_rng mutations(config_.seed, kMutationStream);
+  jaco_rng seeds(config_.seed, kSeedStream);
+
+  Report report;
+  report.chart = start;
+  std::uint64_t common_seed = seeds() | 1u;
+
+  for (long long iteration = 0; iteration < config_.iterations; ++iteration) {
+    if (config_.time_budget > 0.0) {
+      const std::chrono::duration<double> spent =
+          std::chrono::steady_clock::now() - begin;
+      if (spent.count() >= config_.time_budget) {
+        break;
+      }
+    }
+    if (config_.reseed_every > 0 && iteration > 0 &&
+        iteration % config_.reseed_every == 0) {
+      common_seed = seeds() | 1u;
+    }
+
+    // Change one cell of one upcard to a different legal action.
+    const Cell& row = rows[mutations.Below(static_cast<std::uint32_t>(rows.size()))];
+    const int upcard = static_cast<int>(mutations.Below(jaco_strategy_chart::kUpcards));
+    const int actions = row.hand_class == HandClass::Pair ? 4 : 3;
+    const int current =
+        static_cast<int>(report.chart.Lookup(row.hand_class, row.total, upcard));
+    int proposed = static_cast<int>(mutations.Below(actions - 1));
+    if (proposed >= current) {
+      ++proposed;
+    }
+    jaco_strategy_chart candidate = report.chart;
+    candidate.Set(row.hand_class, row.total, upcard,
+                  static_cast<ITable::Action>(proposed));
+
+    const auto paired = Evaluate(report.chart, candidate, common_seed, config_.sessions);
+    ++report.iterations;
+    const jaco_stats& difference = paired.strategies[1].difference;
+    if (difference.Mean() - difference.HalfWidth() > 0.0) {
+      report.chart = candidate;
+      ++report.accepted;
+    }
+  }
+  const std::chrono::duration<double> spent =
+      std::chrono::steady_clock::now() - begin;
+  report.elapsed = spent.count();
+
+  // Fresh shoes for an unbiased comparison with the starting chart.
+  const std::uint64_t validation_seed = seeds() | 1u;
+  const auto validation =
+      Evaluate(start, report.chart, validation_seed, config_.validation_sessions);
+  report.start_ev = validation.strategies[0].round_ev;
+  report.best_ev = validation.strategies[1].round_ev;
+  report.improvement = validation.strategies[1].difference;
+  return report;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#ifndef JACO_OPTIMIZER_H
+#define JACO_OPTIMIZER_H
+#include "NewBJ/jaco_simulator.h"
+#include "NewBJ/jaco_stats.h"
+#include "NewBJ/jaco_strategy_chart.h"
+#include <cstdint>
+
+/**
+ * @class jaco_optimizer
+ * @brief Local search over strategy charts scored by simulation.
+ *
+ * Each iteration changes one decision cell of the current chart and plays
+ * the candidate against the incumbent in one paired @ref jaco_simulator run
+ * on every core (see @ref jaco_simulator::Config::compare): both charts are
+ * dealt every round from the same shoe (common random numbers), so the
+ * per-round EV difference carries little card noise. A candidate replaces
+ * the incumbent only when the 95% confidence interval of that difference
+ * lies entirely above zero, so neutral mutations are not accepted on noise.
+ *
+ * The common seed is renewed every @ref Config::reseed_every iterations so
+ * the search does not overfit one set of shoes, and the final chart is
+ * re-measured against the starting chart on a seed never used in the
+ * search to give an unbiased confidence interval.
+ */
+class jaco_optimizer {
+public:
+    /**
+     * @struct Config
+     * @brief Parameters of an optimization run.
+     */
+    struct Config {
+        jaco_rules::GameType mode = jaco_rules::GameType::CLASSIC; ///< Rules to optimize for
+        long long iterations = 1000;        ///< Candidates to evaluate
+        double time_budget = 0.0;           ///< Wall-clock limit in seconds (0 = none)
+        long long sessions = 64;            ///< Sessions per evaluation
+        long long rounds_per_session = 500; ///< Rounds per session
+        long long reseed_every = 100;       ///< Iterations per common seed (0 = one seed)
+        long long validation_sessions = 1024; ///< Sessions of the final measurement
+        int players = 4;                    ///< Players seated at each table
+        int threads = 0;                    ///< Worker threads (0 = hardware concurrency)
+        int penetration = jaco_rules::kShoePenetration; ///< Cut card position in percent
+        std::uint64_t seed = 0;             ///< Master seed of the search (0 = random)
+    };
+
+    /**
+     * @struct Report
+     * @brief Outcome of @ref Run.
+     */
+    struct Report {
+        jaco_strategy_chart chart;   ///< Best chart found
+        long long iterations = 0;    ///< Candidates evaluated
+        long long accepted = 0;      ///< Candidates that replaced the incumbent
+        double elapsed = 0.0;        ///< Seconds spent searching
+        jaco_stats start_ev;         ///< Validation EV of the starting chart (per round and seat)
+        jaco_stats best_ev;          ///< Validation EV of the best chart
+        jaco_stats improvement;      ///< Paired per-round difference best - start
+    };
+
+    /**
+     * @brief Prepares an optimizer.
+     * @param config Search parameters.
+     */
+    explicit jaco_optimizer(const Config& config);
+
+    /**
+     * @brief Runs the local search from @p start.
+     * @param start Initial chart (built-in, solved or loaded).
+     * @return Report Best chart with its validation statistics.
+     */
+    Report Run(const jaco_strategy_chart& start);
+
+    /**
+     * @brief Gets the master seed of the search (drawn at random if none was given).
+     */
+    std::uint64_t Seed() const { return config_.seed; }
+
+private:
+    /**
+     * @brief Plays @p sessions paired sessions of @p challenger against
+     * @p incumbent on the same shoes.
+     * @return Results whose strategies[1].difference is challenger - incumbent
+     * per round.
+     */
+    jaco_simulator::Results Evaluate(const jaco_strategy_chart& incumbent,
+                                     const jaco_strategy_chart& challenger,
+                                     std::uint64_t seed, long long sessions) const;
+
+    /** @brief Search parameters. */
+    Config config_;
+};
+
+#endif // JACO_OPTIMIZER_H
@@ -0,0 +1,452 @@
+#include "NewBJ/jaco_perf.h"
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+  using Counts = jaco_perf::Counts;
+  constexpr int kEvents = jaco_perf::kEvents;
+
+  /**
+   * @brief Totals of the threads whose scope has ended.
+   */
+  struct Registry {
+    std::mutex mutex;
+    jaco_perf::Snapshot totals;
+  };
+
+  /**
+   * @brief Without rdpmc, one round in this many is split by phase, so the
+   * read() syscalls at its boundaries stay out of the other rounds.
+   */
+  constexpr std::uint64_t kReadSampleRounds = 16;
+
+  Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+  }
+
+#ifdef __linux__
+
+  /**
+   * @brief Reads hardware counter @p index from user space.
+   */
+  inline std::uint64_t ReadPmc(std::uint32_t index) {
+#if defined(__x86_64__) || defined(__i386__)
+    std::uint32_t low = 0;
+    std::uint32_t high = 0;
+    __asm__ __volatile__("rdpmc" : "=a"(low), "=d"(high) : "c"(index));
+    return static_cast<std::uint64_t>(high) << 32 | low;
+#else
+    (void)index;
+    return 0;
+#endif
+  }
+
+  /**
+   * @brief Sets the perf_event_attr type and config of an Event.
+   */
+  void Describe(int event, perf_event_attr& attr) {
+    attr.type = PERF_TYPE_HARDWARE;
+    std::uint64_t config = 0;
+    switch (static_cast<jaco_perf::Event>(event)) {
+      case jaco_perf::Event::Cycles:
+        config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case jaco_perf::Event::Instructions:
+        config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case jaco_perf::Event::BranchMisses:
+        config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      case jaco_perf::Event::L1DMisses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+      case jaco_perf::Event::LLCMisses:
+      default:
+        config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    }
+    attr.config = config;
+  }
+
+  /**
+   * @brief Opens one event of the calling thread, user space only.
+   *
+   * @param group_fd Group leader, or -1 to open a disabled leader.
+   * @return File descriptor, or -1 with errno set.
+   */
+  int OpenEvent(int event, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    Describe(event, attr);
+    attr.disabled = group_fd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+  }
+
+  const char* Explain(int error) {
+    switch (error) {
+      case EACCES:
+      case EPERM:
+        return "not permitted (perf_event_paranoid or a container seccomp profile)";
+      case ENOENT:
+      case EOPNOTSUPP:
+        return "no hardware PMU exposed (virtual machine or container)";
+      case ENOSYS:
+        return "perf_event_open is not supported by this kernel";
+      default:
+        return std::strerror(error);
+    }
+  }
+
+  /**
+   * @brief The calling thread's counter group.
+   *
+   * Phase boundaries read the counters with rdpmc through each event's
+   * perf_event_mmap_page when the kernel allows it: a few dozen cycles and
+   * no kernel entry, so the measurement barely disturbs the phases. Without
+   * it, only one round in @ref kReadSampleRounds is split with read().
+   */
+  struct ThreadCounters {
+    int leader = -1;
+    int fds[kEvents] = {-1, -1, -1, -1, -1};
+    int slot[kEvents] = {};       ///< Position of each open event in a group read
+    int opened = 0;
+    std::uint32_t available = 0;
+    Counts start{};               ///< Counts when the scope began
+    Counts baseline{};            ///< Counts at the last phase boundary
+    std::array<Counts, jaco_profile::kPhases> phases{};
+    bool phased = false;
+    const perf_event_mmap_page* pages[kEvents] = {};  ///< User pages for rdpmc
+    bool rdpmc = false;           ///< Every open event can be read with rdpmc
+    std::uint64_t rounds = 0;     ///< Rounds begun since the scope began
+    std::uint64_t phase_rounds = 0;  ///< Rounds split by phase
+    bool sampling = false;        ///< The current round is split by phase
+
+    bool Open() {
+      leader = OpenEvent(0, -1);
+      if (leader < 0) {
+        return false;
+      }
+      fds[0] = leader;
+      slot[0] = opened++;
+      available = 1U;
+      // Events the CPU lacks are left out rather than failing the group.
+      for (int e = 1; e < kEvents; ++e) {
+        fds[e] = OpenEvent(e, leader);
+        if (fds[e] >= 0) {
+          slot[e] = opened++;
+          available |= 1U << e;
+        }
+      }
+      ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      Read(start);
+      baseline = start;
+      return true;
+    }
+
+    /**
+     * @brief Maps the user page of every event; enables rdpmc if all allow it.
+     */
+    void MapPages() {
+#if defined(__x86_64__) || defined(__i386__)
+      const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      rdpmc = true;
+      for (int e = 0; e < kEvents; ++e) {
+        if (fds[e] < 0) {
+          continue;
+        }
+        void* mapping = ::mmap(nullptr, page, PROT_READ, MAP_SHARED, fds[e], 0);
+        if (mapping == MAP_FAILED) {
+          rdpmc = false;
+          continue;
+        }
+        pages[e] = static_cast<const perf_event_mmap_page*>(mapping);
+        rdpmc = rdpmc && pages[e]->cap_user_rdpmc;
+      }
+#endif
+    }
+
+    /**
+     * @brief Reads every event with rdpmc (unscaled).
+     * @return false if an event is not on a counter right now (multiplexed
+     * out or rdpmc revoked); @p counts is then partly written.
+     */
+    bool ReadUser(Counts& counts) const {
+      for (int e = 0; e < kEvents; ++e) {
+        if (pages[e] == nullptr) {
+          continue;
+        }
+        const volatile perf_event_mmap_page* pc = pages[e];
+        std::uint32_t sequence = 0;
+        std::int64_t value = 0;
+        do {
+          sequence = pc->lock;
+          __atomic_signal_fence(__ATOMIC_SEQ_CST);
+          const std::uint32_t index = pc->index;
+          if (!pc->cap_user_rdpmc || index == 0 || pc->pmc_width == 0) {
+            return false;
+          }
+          // Sign-extend the pmc_width bits of the hardware counter.
+          const int shift = 64 - pc->pmc_width;
+          const std::int64_t pmc =
+              static_cast<std::int64_t>(ReadPmc(index - 1) << shift) >> shift;
+          value = pc->offset + pmc;
+          __atomic_signal_fence(__ATOMIC_SEQ_CST);
+        } while (pc->lock != sequence);
+        counts[e] = static_cast<std::uint64_t>(value);
+      }
+      return true;
+    }
+
+    /**
+     * @brief Reads the group, scaled up if the kernel multiplexed it.
+     * @return false (and @p counts untouched) if nothing could be read.
+     */
+    bool Read(Counts& counts) const {
+      std::uint64_t buffer[3 + kEvents] = {};
+      if (::read(leader, buffer, sizeof(buffer)) <= 0 || buffer[2] == 0) {
+        return false;
+      }
+      const double scale = static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]);
+      for (int e = 0; e < kEvents; ++e) {
+        if ((available >> e & 1U) != 0) {
+          counts[e] = static_cast<std::uint64_t>(static_cast<double>(buffer[3 + slot[e]]) * scale);
+        }
+      }
+      return true;
+    }
+
+    void Close() {
+      const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      for (int e = kEvents - 1; e >= 0; --e) {
+        if (pages[e] != nullptr) {
+          ::munmap(const_cast<perf_event_mmap_page*>(pages[e]), page);
+          pages[e] = nullptr;
+        }
+        if (fds[e] >= 0) {
+          ::close(fds[e]);
+          fds[e] = -1;
+        }
+      }
+      leader = -1;
+    }
+  };
+
+  thread_local ThreadCounters* t_counters = nullptr;
+
+  /**
+   * @brief jaco_profile observer: charges the counts since the last boundary.
+   */
+  void OnPhase(jaco_profile::Phase phase, bool round_start) {
+    ThreadCounters& counters = *t_counters;
+    if (round_start) {
+      counters.sampling =
+          counters.rdpmc || counters.rounds % kReadSampleRounds == 0;
+      ++counters.rounds;
+    }
+    if (!counters.sampling) {
+      return;
+    }
+    Counts now{};
+    // rdpmc and read() count differently under multiplexing: drop a round
+    // that needed both rather than mixing them.
+    const bool read = counters.rdpmc ? counters.ReadUser(now) : counters.Read(now);
+    if (!read) {
+      counters.sampling = false;
+      return;
+    }
+    if (round_start) {
+      ++counters.phase_rounds;
+    } else {
+      Counts& into = counters.phases[static_cast<int>(phase)];
+      for (int e = 0; e < kEvents; ++e) {
+        into[e] += now[e] - counters.baseline[e];
+      }
+      counters.phased = true;
+    }
+    counters.baseline = now;
+  }
+#endif
+
+}  // namespace
+
+const char* jaco_perf::EventName(Event event) {
+  switch (event) {
+    case Event::Cycles:
+      return "cycles";
+    case Event::Instructions:
+      return "instructions";
+    case Event::BranchMisses:
+      return "branch-misses";
+    case Event::L1DMisses:
+      return "L1D-read-misses";
+    case Event::LLCMisses:
+      return "LLC-misses";
+    default:
+      return "unknown";
+  }
+}
+
+bool jaco_perf::Probe(std::string& reason) {
+#ifdef __linux__
+  const int fd = OpenEvent(0, -1);
+  if (fd < 0) {
+    reason = Explain(errno);
+    return false;
+  }
+  ::close(fd);
+  reason.clear();
+  return true;
+#else
+  reason = "hardware counters are only read on Linux";
+  return false;
+#endif
+}
+
+jaco_perf::ThreadScope::ThreadScope(bool enabled, bool by_phase) {
+#ifdef __linux__
+  if (!enabled || t_counters != nullptr) {
+    return;
+  }
+  auto* counters = new ThreadCounters();
+  if (!counters->Open()) {
+    delete counters;
+    return;
+  }
+  t_counters = counters;
+  owner_ = true;
+  // Totals alone need no reads until the scope ends.
+  if (by_phase && jaco_profile::kEnabled) {
+    counters->MapPages();
+    jaco_profile::SetObserver(&OnPhase);
+  }
+#else
+  (void)enabled;
+  (void)by_phase;
+  (void)owner_;
+#endif
+}
+
+/**
+ * @brief Folds the thread's counts into the registry and closes the group.
+ */
+jaco_perf::ThreadScope::~ThreadScope() {
+#ifdef __linux__
+  if (!owner_) {
+    return;
+  }
+  ThreadCounters* counters = t_counters;
+  if (jaco_profile::kEnabled) {
+    jaco_profile::SetObserver(nullptr);
+  }
+  Counts end = counters->start;
+  counters->Read(end);
+  counters->Close();
+  t_counters = nullptr;
+
+  Registry& registry = GetRegistry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    Snapshot& totals = registry.totals;
+    totals.available = totals.threads == 0 ? counters->available
+                                           : totals.available & counters->available;
+    ++totals.threads;
+    totals.phased = totals.phased || counters->phased;
+    totals.phase_rounds += static_cast<long long>(counters->phase_rounds);
+    totals.rdpmc_threads += counters->rdpmc ? 1 : 0;
+    for (int e = 0; e < kEvents; ++e) {
+      totals.total[e] += end[e] - counters->start[e];
+      for (int p = 0; p < jaco_profile::kPhases; ++p) {
+        totals.phases[p][e] += counters->phases[p][e];
+      }
+    }
+  }
+  delete counters;
+#endif
+}
+
+jaco_perf::Snapshot jaco_perf::Collect() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.totals;
+}
+
+void jaco_perf::Report(std::ostream& out, const Snapshot& snapshot, long long rounds) {
+  if (snapshot.threads == 0) {
+    out << "No thread opened hardware counters\n";
+    return;
+  }
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  const double per_million = rounds > 0 ? 1e6 / static_cast<double>(rounds) : 0.0;
+
+  out << std::left << std::setw(17) << "Event" << std::right << std::setw(18) << "total"
+      << std::setw(18) << "per 1M rounds" << "\n";
+  out << std::fixed << std::setprecision(0);
+  for (int e = 0; e < kEvents; ++e) {
+    const Event event = static_cast<Event>(e);
+    out << std::left << std::setw(17) << EventName(event) << std::right;
+    if (!snapshot.Has(event)) {
+      out << std::setw(18) << "n/a" << "\n";
+      continue;
+    }
+    out << std::setw(18) << snapshot.total[e] << std::setw(18)
+        << static_cast<double>(snapshot.total[e]) * per_million << "\n";
+  }
+  out << std::setprecision(2);
+  if (snapshot.Has(Event::Instructions) && snapshot.total[0] > 0) {
+    out << "IPC              : "
+        << static_cast<double>(snapshot.total[1]) / static_cast<double>(snapshot.total[0])
+        << "\n";
+  }
+
+  if (snapshot.phased && snapshot.phase_rounds > 0) {
+    const double per_phase_round = 1e6 / static_cast<double>(snapshot.phase_rounds);
+    out << "Per 1M rounds by phase, from " << snapshot.phase_rounds << " rounds read with "
+        << (snapshot.rdpmc_threads == snapshot.threads ? "rdpmc"
+            : snapshot.rdpmc_threads == 0              ? "read(), 1 round in "
+                                                       : "rdpmc or read(), 1 round in ");
+    if (snapshot.rdpmc_threads != snapshot.threads) {
+      out << kReadSampleRounds;
+    }
+    out << ":\n"
+        << std::left << std::setw(17) << "Phase" << std::right;
+    for (int e = 0; e < kEvents; ++e) {
+      if (snapshot.Has(static_cast<Event>(e))) {
+        out << std::setw(17) << EventName(static_cast<Event>(e));
+      }
+    }
+    out << "\n" << std::setprecision(0);
+    for (int p = 0; p < jaco_profile::kPhases; ++p) {
+      out << std::left << std::setw(17)
+          << jaco_profile::PhaseName(static_cast<jaco_profile::Phase>(p)) << std::right;
+      for (int e = 0; e < kEvents; ++e) {
+        if (snapshot.Has(static_cast<Event>(e))) {
+          out << std::setw(17) << static_cast<double>(snapshot.phases[p][e]) * per_phase_round;
+        }
+      }
+      out << "\n";
+    }
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
@@ -0,0 +1,111 @@
+#pragma once
+#ifndef JACO_PERF_H
+#define JACO_PERF_H
+#include "NewBJ/jaco_profile.h"
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @class jaco_perf
+ * @brief Hardware performance counters of the simulation worker threads.
+ *
+ * On Linux each worker opens one perf_event_open group (cycles,
+ * instructions, branch misses, L1D read misses, LLC misses) counting its own
+ * user-space execution, and folds the totals into a process-wide snapshot
+ * when it exits; counting totals adds nothing to the rounds. When the phase
+ * timers are compiled in (@ref JACO_PROFILE_PHASES) and a scope asks for
+ * it, the group is also read at every round phase boundary, which splits
+ * the counts by @ref jaco_profile::Phase. Those reads use rdpmc where the
+ * kernel allows it; otherwise one round in 16 is split with read() syscalls.
+ *
+ * Counters are often unavailable (containers, virtual machines without a
+ * PMU, perf_event_paranoid, other systems): @ref Probe reports why, a
+ * @ref ThreadScope then counts nothing, and events a CPU does not support
+ * are left out of the report.
+ */
+class jaco_perf {
+public:
+    /**
+     * @enum Event
+     * @brief Counted hardware events, in group order.
+     */
+    enum class Event : int {
+        Cycles = 0,
+        Instructions,
+        BranchMisses,
+        L1DMisses,  ///< L1 data cache read misses
+        LLCMisses,  ///< Last level cache misses
+        Count
+    };
+
+    static constexpr int kEvents = static_cast<int>(Event::Count);
+
+    /** @brief Per-event counts. */
+    using Counts = std::array<std::uint64_t, kEvents>;
+
+    /**
+     * @struct Snapshot
+     * @brief Counts of every worker that had counters.
+     */
+    struct Snapshot {
+        int threads = 0;               ///< Threads whose counters opened
+        std::uint32_t available = 0;   ///< Bit per Event counted by every such thread
+        bool phased = false;           ///< @ref phases was filled
+        long long phase_rounds = 0;    ///< Rounds summed in @ref phases
+        int rdpmc_threads = 0;         ///< Threads that read the phases with rdpmc
+        Counts total{};                ///< Whole lifetime of the threads
+        std::array<Counts, jaco_profile::kPhases> phases{};  ///< Split by round phase
+
+        bool Has(Event event) const {
+            return (available >> static_cast<int>(event) & 1U) != 0;
+        }
+    };
+
+    static const char* EventName(Event event);
+
+    /**
+     * @brief Checks whether counters can be opened on this machine.
+     *
+     * @param reason Receives why not (empty on success).
+     * @return true if at least the cycle counter opens.
+     */
+    static bool Probe(std::string& reason);
+
+    /**
+     * @class ThreadScope
+     * @brief Counts the calling thread from construction to destruction.
+     */
+    class ThreadScope {
+    public:
+        /**
+         * @param enabled Open the counters; false makes the scope a no-op.
+         * @param by_phase Also split the counts by round phase (needs
+         *                 JACO_PROFILE_PHASES; ignored otherwise).
+         */
+        explicit ThreadScope(bool enabled, bool by_phase = false);
+        ~ThreadScope();
+        ThreadScope(const ThreadScope&) = delete;
+        ThreadScope& operator=(const ThreadScope&) = delete;
+
+    private:
+        /** @brief This scope opened the thread's counters (not a nested one). */
+        bool owner_ = false;
+    };
+
+    /**
+     * @brief Sums the counts of every thread whose scope has ended.
+     */
+    static Snapshot Collect();
+
+    /**
+     * @brief Prints the totals and the phase split per million rounds.
+     *
+     * The phase split is scaled by the rounds it was read on
+     * (Snapshot::phase_rounds), the totals by @p rounds.
+     */
+    static void Report(std::ostream& out, const Snapshot& snapshot, long long rounds);
+};
+
+#endif // JACO_PERF_H
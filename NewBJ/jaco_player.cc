@@ -2,155 +2,138 @@
 #ifndef JACO_PLAYER_CC
 #define JACO_PLAYER_CC
 #include "NewBJ/jaco_player.h"
+#include "NewBJ/jaco_table.h"
+#include "NewBJ/jaco_log.h"
+#include "NewBJ/jaco_alloc.h"
 
-// Initialize to 0 variable static next_player_index to auto-increment player IDs
-int jaco_player::next_player_index = 0;
+/**
+ * @brief Appends a card and updates hard total, ace count and pair flag.
+ */
+void jaco_player::PushCard(Hand& hand, const Cards::Card& card){
+	if(!hand.cards.push_back(card)){
+		JACO_LOG(Error) << "Error: Hand " << static_cast<int>(hand.hand_index) << " is full\n";
+		return;
+	}
+	// Jack, Queen and King are worth 10, aces are counted as 1 here.
+	hand.hard_total += Cards::Points(card);
+	if(card.value_ == Cards::Value::ACE){
+		++hand.aces;
+	}
+	hand.pair = hand.cards.size() == 2 && hand.cards[0].value_ == hand.cards[1].value_;
+}
 
 void jaco_player::AddCard(const Cards::Card& card, int hand_index){
 	if(PlayerHand.empty()){
-		std::cout << "Error: No hand initialized for player " << player_index << std::endl;
+		JACO_LOG(Error) << "Error: No hand initialized for player " << player_index << "\n";
 		return;
 	}
 	const int target = (PlayerHand.size() == 1) ? 0 : hand_index;
 	if(target < 0 || target >= static_cast<int>(PlayerHand.size())){
-		std::cout << "Error: Invalid hand index " << hand_index << " for player " << player_index << std::endl;
+		JACO_LOG(Error) << "Error: Invalid hand index " << hand_index << " for player " << player_index << "\n";
 		return;
 	}
-	PlayerHand[target].cards.push_back(card);
+	PushCard(PlayerHand[target], card);
 	return;
 }
 
+int jaco_player::SplitHand(int hand_index){
+	if(!IsPair(hand_index) || PlayerHand.full()){
+		return -1;
+	}
+	Hand& hand = PlayerHand[hand_index];
+	const Cards::Card moved = hand.cards.back();
+	// Both cards are equal, so the remaining hand is exactly half of the pair.
+	hand.cards.pop_back();
+	hand.hard_total /= 2;
+	hand.aces /= 2;
+	hand.pair = false;
+
+	Hand new_hand;
+	new_hand.hand_index = static_cast<std::int8_t>(PlayerHand.size());
+	PushCard(new_hand, moved);
+	PlayerHand.push_back(new_hand);
+	return new_hand.hand_index;
+}
+
 /**
  * @brief Prints hand's cards and scores for each hand.
  * 
  * First iterates through player's hands and then iterates all cards
- * in each hand to print them to standard output using @ref Cards::PrintFig and
+ * in each hand to write them to the log (Info level) using @ref Cards::PrintFig and
  * @ref Cards::PrintSuit, along with each hand score using @ref HandScore
  */
 void jaco_player::ShowHand() const{
-	std::cout << "  Player " << player_index << "'s hands: " << std::endl;
+	if(!jaco_log::Enabled(jaco_log::Level::Info)){
+		return;
+	}
+	std::ostream& out = jaco_log::Stream();
+	out << "  Player " << player_index << "'s hands: \n";
 	for(const auto& hand : PlayerHand){
-		std::cout << "  Hand " << hand.hand_index << ":" << std::endl;
+		out << "  Hand " << static_cast<int>(hand.hand_index) << ":\n";
 		for(const auto &c : hand.cards){
-			std::cout << "   " << Cards::PrintFig(c.fig) << " of " << Cards::PrintSuit(c.suit) << std::endl;
+			out << "   " << Cards::PrintFig(c.value_) << " of " << Cards::PrintSuit(c.suit_) << "\n";
 		}
-		std::cout << "   Score: " << HandScore(hand.hand_index) << std::endl;
+		out << "   Score: " << HandScore(hand.hand_index) << "\n";
 	}
 }
 
 void jaco_player::InitHand(Cards& deck){
+	JACO_ALLOC_SCOPE(Hands);
 	PlayerHand.clear(); //Erase hands
 	//Create first hand
 	Hand first_hand;
 	first_hand.hand_index = 0;
 	//Add two cards from the deck
-	first_hand.cards.push_back( deck.giveCard() );
-	first_hand.cards.push_back( deck.giveCard() );
+	PushCard(first_hand, deck.giveCard());
+	PushCard(first_hand, deck.giveCard());
 	// Add hand to PlayerHand
 	PlayerHand.push_back(first_hand);
 }
 
-int jaco_player::HandScore(int hand_index) const{
-	if(hand_index < 0 || hand_index >= static_cast<int>(PlayerHand.size())){
-		return 0;
-	}
-	int score = 0;
-	int aces = 0;
-	// Iterate though cards in the specified hand
-	for(const auto& c : PlayerHand[hand_index].cards){
-		// Add score according to card value
-		switch(c.fig){
-			case Cards::Value::Ace: 	score+=11; ++aces;
-				break;
-			case Cards::Value::Two:  	score+=2;  break;  
-			case Cards::Value::Three: 	score+=3;  break;
-			case Cards::Value::Four: 	score+=4;  break;
-			case Cards::Value::Five: 	score+=5;  break;
-			case Cards::Value::Six: 	score+=6;  break;
-			case Cards::Value::Seven: 	score+=7;  break;
-			case Cards::Value::Eight: 	score+=8;  break;
-			case Cards::Value::Nine: 	score+=9;  break;
-			case Cards::Value::Ten: 	score+=10; break;
-			case Cards::Value::Jack : 	score+=10; break;
-			case Cards::Value::Queen: 	score+=10; break;
-			case Cards::Value::King: 	score+=10; break;
-		}
-	}
-	//Adjust Aces if score > rules_.GetWinPoint()
-	while(score > rules_.GetWinPoint() && aces > 0){
-		score -= 10;
-		--aces;
-	}
-	return score;
-}
-
 /**
- * @brief Basic strategy-like decision for player action including split heuristics.
+ * @brief Looks the hand up in the player's strategy chart.
  */
 ITable::Action jaco_player::DecidePlayerAction(const ITable& table, int player_index, int hand_index){
+	return Decide(table, player_index, hand_index);
+}
+
+template <class Table>
+ITable::Action jaco_player::Decide(const Table& table, int player_index, int hand_index) const{
 	// Fallback guard.
 	if(hand_index < 0 || hand_index >= static_cast<int>(PlayerHand.size())){
 		return ITable::Action::Stand;
 	}
 
-	const auto& hand = PlayerHand[hand_index].cards;
-	// Choose dealer upcard value (treat face cards as 10, Ace as 11 surrogate).
-	int dealer_up = 0;
-	const auto dealer_card = table.GetDealerCard();
-	switch(dealer_card.value_){
-		case ITable::Value::ACE: 	dealer_up = 11; break;
-		case ITable::Value::TWO: 	dealer_up = 2; 	break;
-		case ITable::Value::THREE: 	dealer_up = 3; 	break;
-		case ITable::Value::FOUR: 	dealer_up = 4; 	break;
-		case ITable::Value::FIVE: 	dealer_up = 5; 	break;
-		case ITable::Value::SIX: 	dealer_up = 6; 	break;
-		case ITable::Value::SEVEN: 	dealer_up = 7; 	break;
-		case ITable::Value::EIGHT: 	dealer_up = 8; 	break;
-		case ITable::Value::NINE: 	dealer_up = 9; 	break;
-		default: dealer_up = 10; break;
+	using HandClass = jaco_strategy_chart::HandClass;
+	const Hand& hand = PlayerHand[hand_index];
+	// A doubled hand has already taken its one extra card.
+	if(hand.doubled){
+		return ITable::Action::Stand;
 	}
+	const int upcard = Cards::Rank(table.GetDealerCard());
 
-	// Split logic only when exactly 2 cards and same rank.
-	if(hand.size() == 2 && hand[0].fig == hand[1].fig){
-		const auto pair_val = hand[0].fig;
-		const bool dealer_weak_2_7 = dealer_up >= 2 && dealer_up <= 7;
-		const bool dealer_weak_2_6 = dealer_up >= 2 && dealer_up <= 6;
-
-		if(pair_val == Cards::Value::Ace){
-			return ITable::Action::Split; // Always split A,A
+	// Pairs have their own rows while the hand can still be split.
+	if(hand.pair && !PlayerHand.full()){
+		const auto action = jaco_strategy_chart::Lookup(strategy_, HandClass::Pair, Cards::Rank(hand.cards[0]), upcard);
+		if(action != ITable::Action::Split || player_money >= table.GetPlayerCurrentBet(player_index, hand_index)){
+			return action;
 		}
-		if(pair_val == Cards::Value::Eight){
-			return ITable::Action::Split; // Always split 8,8
-		}
-		if(pair_val == Cards::Value::Two || pair_val == Cards::Value::Three){
-			if(dealer_weak_2_7) return ITable::Action::Split;
-		}
-		if(pair_val == Cards::Value::Seven){
-			if(dealer_weak_2_7) return ITable::Action::Split;
-		}
-		if(pair_val == Cards::Value::Six){
-			if(dealer_weak_2_6) return ITable::Action::Split;
-		}
-		if(pair_val == Cards::Value::Nine){
-			if((dealer_up >= 2 && dealer_up <= 6) || dealer_up == 8 || dealer_up == 9){
-				return ITable::Action::Split;
-			}
-		}
-		if(pair_val == Cards::Value::Four){
-			if(dealer_up == 5 || dealer_up == 6){
-				return ITable::Action::Split;
-			}
-		}
-		// Never split 5s, 10s/face; fall through to hit/stand logic.
 	}
 
-	// Simple hit/stand heuristic: hit below 17.
-	if(NeedCard(hand_index)){
+	const int score = HandScore(hand_index);
+	const auto hand_class = score != hand.hard_total ? HandClass::Soft : HandClass::Hard;
+	const auto action = jaco_strategy_chart::Lookup(strategy_, hand_class, score, upcard);
+	// Without the money to double, take the card anyway.
+	if(action == ITable::Action::Double && player_money < table.GetPlayerCurrentBet(player_index, hand_index)){
 		return ITable::Action::Hit;
 	}
-	return ITable::Action::Stand;
+	return action;
 }
 
+// Decision logic for the IPlayer adapter and for the static jaco_table path.
+template ITable::Action jaco_player::Decide<ITable>(const ITable&, int, int) const;
+template ITable::Action jaco_player::Decide<jaco_table>(const jaco_table&, int, int) const;
+
 int jaco_player::DecideInitialBet(const ITable& table, int player_index){
 	const int hand0 = PlayerHand.empty() ? 0 : HandScore(0);
 	const int hand1 = (PlayerHand.size() > 1) ? HandScore(1) : 0;
@@ -3,7 +3,11 @@
 #define JACO_PLAYER_H
 #include "Interface/iplayer.h"
 #include "NewBJ/jaco_rules.h"
+#include "NewBJ/jaco_rules_policy.h"
 #include "NewBJ/cards.h"
+#include "NewBJ/jaco_fixed_vector.h"
+#include "NewBJ/jaco_strategy_chart.h"
+#include <cstdint>
 /**
  * @class jaco_player
  * @brief Represents a Blackjack player with hand management and betting logic.
@@ -12,39 +16,62 @@
  * associated with a single player: money, current bet, and their hands.
  * It also provides helper methods for hand scoring and basic Blackjack
  * conditions such as bust and Blackjack detection.
+ *
+ * The class is final so that calls made on a jaco_player (rather than through
+ * an IPlayer reference) bind statically and can be inlined by the game loop.
  */
-class jaco_player : public IPlayer {
+class jaco_player final : public IPlayer {
     public:
         /**
          * @brief Constructs a player with a given index and initial money.
          *
          * Initializes the player identifier, starting money using
          * @ref jaco_rules::kPlayerStartMoney, and sets the current bet to zero.
-         * Uses @ref next_player_index as a static counter to assign unique
-         * player indices when a new player is created.
+         * The index is taken from the caller so that several tables can be
+         * built concurrently without sharing any global counter.
          *
-         * @param player_index Index of the player at the table (unused, kept for API compatibility).
+         * @param player_index Index of the player at the table.
          * @param rules Reference to the active game rules.
          */
         jaco_player(int player_index, 
                     const jaco_rules& rules) 
-            : player_index(next_player_index++), 
+            : player_index(player_index), 
             player_money(jaco_rules::kPlayerStartMoney), 
             current_bet(0),
-            rules_(rules) {}
-        
+            rules_(rules),
+            strategy_(jaco_strategy_chart::Default(rules).data()) {}
+
+        /**
+         * @brief Replaces the strategy chart used by @ref DecidePlayerAction.
+         *
+         * The entries are not copied: they may belong to a
+         * @ref jaco_strategy_chart or to a memory-mapped @ref jaco_chart_file
+         * that outlives the player.
+         *
+         * @param entries jaco_strategy_chart::kEntries bytes, or nullptr for
+         *        the built-in chart of the game mode.
+         */
+        void SetStrategy(const std::uint8_t* entries){
+            strategy_ = entries != nullptr ? entries : jaco_strategy_chart::Default(rules_).data();
+        }
+
         /**
-         * @brief Shared player index (used as an identifier counter).
+         * @name Seat storage limits
+         * @brief Capacities of the inline hand storage.
          *
-         * This static member can be used to generate or track the current
-         * player index across multiple instances.
+         * A hand busts long before holding 24 cards for every supported rule
+         * set (at most 22 cards with 8 decks and a win point of 21, 17 in
+         * EXTREME), and a pair can be split into at most four hands.
          */
-        static int next_player_index;
+        ///@{
+        static constexpr int kMaxHandCards = 24;  ///< Cards per hand
+        static constexpr int kMaxHands     = 4;   ///< Hands per player, counting splits
+        ///@}
 
         /**
          * @brief Unique identifier for the player at the table.
          *
-         * Assigned automatically using @ref next_player_index during construction.
+         * Seat index given at construction.
          */
         int player_index;
 
@@ -86,9 +113,21 @@ class jaco_player : public IPlayer {
         void AddCard(const Cards::Card &card, int hand_index);
 
         /**
-         * @brief Prints all player hands and their cards to standard output.
+         * @brief Adds a card to an existing hand without validating @p hand_index.
          *
-         * Primarily used for console-based visualization and debugging.
+         * Used by the table's static-dispatch path, which only passes indices
+         * of hands it has just iterated over.
+         *
+         * @param card The card to be added.
+         * @param hand_index Index of an existing hand.
+         */
+        void AddCardUnchecked(const Cards::Card &card, int hand_index){ PushCard(PlayerHand[hand_index], card); }
+
+        /**
+         * @brief Writes all player hands and their cards to the game log.
+         *
+         * Primarily used for console-based visualization and debugging; the
+         * text appears when the log is flushed (see @ref jaco_log).
          */
         void ShowHand() const;
 
@@ -106,31 +145,104 @@ class jaco_player : public IPlayer {
          * @struct Hand
          * @brief Represents a single Blackjack hand held by the player.
          *
-         * Each hand contains its own vector of cards and an index. When the
-         * player splits, multiple Hand instances are stored in @ref PlayerHand.
+         * Each hand contains its own inline array of cards and an index. When
+         * the player splits, multiple Hand instances are stored in @ref PlayerHand.
+         * The running totals are updated by @ref AddCard and @ref SplitHand so
+         * that scoring never has to rescan the cards. A hand fits in 32 bytes.
          */
         typedef struct {
-            std::vector<Cards::Card> cards;
-            int hand_index;
+            jaco_fixed_vector<Cards::Card, kMaxHandCards> cards;
+            std::int8_t hand_index = 0;
+            std::int16_t hard_total = 0;  ///< Sum of the card points with every ace counted as 1
+            std::int8_t aces = 0;         ///< Number of aces in the hand
+            bool pair = false;            ///< Exactly two cards of the same value
+            bool doubled = false;         ///< Bet doubled; the hand takes no more cards
         } Hand;
+        static_assert(sizeof(Hand) == 32, "a hand should fit in 32 bytes");
 
         /**
          * @brief Collection of all active hands owned by the player.
          *
-         * Normally contains one hand, but may contain multiple if the
-         * player performs a split.
+         * Normally contains one hand, but may contain up to @ref kMaxHands
+         * if the player performs splits. Stored inline, so dealing, splitting
+         * and resetting never allocate.
          */
-        std::vector<Hand> PlayerHand;
+        jaco_fixed_vector<Hand, kMaxHands> PlayerHand;
 
         /**
          * @brief Computes the total score of the player's current hand.
          *
          * The score calculation follows Blackjack rules, including proper
-         * handling of Aces (1 or 11 depending on optimal value).
+         * handling of Aces (1 or 11 depending on optimal value). It reads the
+         * running totals of the hand, so the cost does not depend on the
+         * number of cards.
          *
          * @return int The computed hand score.
          */
-        int HandScore(int hand_index) const;
+        int HandScore(int hand_index) const{ return HandScore(hand_index, rules_); }
+
+        /**
+         * @brief Computes the hand score under an explicit rule set.
+         *
+         * With a @ref jaco_static_rules set the win point is a compile-time
+         * constant; the runtime overload passes the player's @ref jaco_rules.
+         *
+         * @param rules Static rule set or @ref jaco_rules.
+         * @return int The computed hand score.
+         */
+        template <class Rules>
+        int HandScore(int hand_index, const Rules& rules) const{
+            if(hand_index < 0 || hand_index >= static_cast<int>(PlayerHand.size())){
+                return 0;
+            }
+            const Hand& hand = PlayerHand[hand_index];
+            return jaco_best_total(hand.hard_total, hand.aces, rules);
+        }
+
+        /**
+         * @brief Checks whether the hand counts at least one ace as 11.
+         *
+         * @return true if the hand is soft, false otherwise.
+         */
+        bool IsSoft(int hand_index) const{
+            return hand_index >= 0 &&
+                   hand_index < static_cast<int>(PlayerHand.size()) &&
+                   HandScore(hand_index) != PlayerHand[hand_index].hard_total;
+        }
+
+        /**
+         * @brief Checks whether the hand holds a splittable pair.
+         *
+         * @return true if the hand has exactly two cards of the same value.
+         */
+        bool IsPair(int hand_index) const{
+            return hand_index >= 0 &&
+                   hand_index < static_cast<int>(PlayerHand.size()) &&
+                   PlayerHand[hand_index].pair;
+        }
+
+        /**
+         * @brief Checks whether a hand cannot take any more cards.
+         *
+         * @return true if the hand holds @ref kMaxHandCards cards.
+         */
+        bool IsHandFull(int hand_index) const{
+            return hand_index >= 0 &&
+                   hand_index < static_cast<int>(PlayerHand.size()) &&
+                   PlayerHand[hand_index].cards.full();
+        }
+
+        /**
+         * @brief Splits a pair into two hands, keeping the running totals in sync.
+         *
+         * Moves the second card of the hand into a new hand appended to
+         * @ref PlayerHand. The caller deals the extra card to each hand.
+         *
+         * @param hand_index Index of the hand holding the pair.
+         * @return int Index of the new hand, or -1 if the hand is not a pair
+         *         or the player already holds @ref kMaxHands hands.
+         */
+        int SplitHand(int hand_index);
 
         /**
          * @brief Determines if the player should draw another card.
@@ -151,10 +263,16 @@ class jaco_player : public IPlayer {
          *
          * @return true if the hand score is greater than 21, false otherwise.
          */
-        bool isBust(int hand_index) const { 
+        bool isBust(int hand_index) const { return isBust(hand_index, rules_); }
+
+        /**
+         * @brief Bust check under an explicit rule set (see @ref HandScore).
+         */
+        template <class Rules>
+        bool isBust(int hand_index, const Rules& rules) const { 
             return hand_index >= 0 &&
                    hand_index < static_cast<int>(PlayerHand.size()) &&
-                   HandScore(hand_index) > rules_.GetWinPoint(); 
+                   HandScore(hand_index, rules) > rules.GetWinPoint(); 
         }
 
         /**
@@ -166,19 +284,26 @@ class jaco_player : public IPlayer {
          *
          * @return true if the player has Blackjack, false otherwise.
          */
-        bool isBlackjack(int hand_index) const { 
+        bool isBlackjack(int hand_index) const { return isBlackjack(hand_index, rules_); }
+
+        /**
+         * @brief Blackjack check under an explicit rule set (see @ref HandScore).
+         */
+        template <class Rules>
+        bool isBlackjack(int hand_index, const Rules& rules) const { 
             return hand_index >= 0 &&
                    hand_index < static_cast<int>(PlayerHand.size()) &&
                    PlayerHand[hand_index].cards.size() == 2 && 
-                   HandScore(hand_index) == rules_.GetWinPoint(); 
+                   HandScore(hand_index, rules) == rules.GetWinPoint(); 
         }
         
         /**
          * @brief Decides the action to take for a specific hand.
          *
-         * This function implements the decision logic for a given player and hand
-         * based on the current table state. It returns one of the allowed actions
-         * such as Stand, Hit, Double, or Split.
+         * The decision is a single lookup in the strategy chart (see
+         * @ref SetStrategy) by hand class, total and dealer upcard. Pairs use
+         * the pair rows while another split is possible; a doubled hand stands.
+         * It returns one of the allowed actions such as Stand, Hit, Double, or Split.
          *
          * @param table Reference to the game table containing the current game state.
          * @param player_index Index of the player making the decision.
@@ -186,6 +311,18 @@ class jaco_player : public IPlayer {
          * @return ITable::Action The chosen action for this hand.
          */
         virtual ITable::Action DecidePlayerAction(const ITable& table, int player_index, int hand_index) override;
+
+        /**
+         * @brief Decision logic shared by the virtual and the static paths.
+         *
+         * @ref DecidePlayerAction calls it with the ITable interface; the game
+         * loop calls it with the concrete @ref jaco_table, so reading the dealer
+         * card is a direct call as well. Instantiated in jaco_player.cc for both.
+         *
+         * @tparam Table ITable or a concrete table type.
+         */
+        template <class Table>
+        ITable::Action Decide(const Table& table, int player_index, int hand_index) const;
         
         /**
          * @brief Decides the initial bet amount for a new round.
@@ -218,6 +355,11 @@ class jaco_player : public IPlayer {
 
     private:
 
+        /**
+         * @brief Adds a card to a hand and updates its running totals.
+         */
+        static void PushCard(Hand& hand, const Cards::Card& card);
+
         /**
          * @brief Reference to the active game rules used by this player.
          *
@@ -225,6 +367,11 @@ class jaco_player : public IPlayer {
          * depending on the selected game mode.
          */
         const jaco_rules& rules_;
+
+        /**
+         * @brief Decision table consulted for every hand (see @ref SetStrategy).
+         */
+        const std::uint8_t* strategy_;
 };
 
 #endif // JACO_PLAYER_H
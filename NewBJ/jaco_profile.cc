@@ -0,0 +1,190 @@
+#include "NewBJ/jaco_profile.h"
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  /**
+   * @brief Background thread of @ref jaco_profile::StartReporting.
+   */
+  struct Reporter {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread thread;
+    bool stop = false;
+  };
+
+  Reporter& GetReporter() {
+    static Reporter reporter;
+    return reporter;
+  }
+
+}  // namespace
+
+/**
+ * @brief Only touched when a thread records its first phase, when it exits
+ * and by @ref Collect; the recording path never takes the lock.
+ */
+struct jaco_profile::Registry {
+  std::mutex mutex;
+  std::vector<const Recorder*> live;
+  Snapshot retired;
+};
+
+jaco_profile::Registry& jaco_profile::GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+jaco_profile::Recorder::Recorder() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.live.push_back(this);
+}
+
+/**
+ * @brief Folds the thread's histograms into the retired totals.
+ */
+jaco_profile::Recorder::~Recorder() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (int p = 0; p < kPhases; ++p) {
+    Histogram& histogram = registry.retired[p];
+    histogram.total_ns += total_ns[p].load(std::memory_order_relaxed);
+    for (int b = 0; b < kBuckets; ++b) {
+      histogram.buckets[b] += buckets[p][b].load(std::memory_order_relaxed);
+    }
+  }
+  registry.live.erase(std::remove(registry.live.begin(), registry.live.end(), this),
+                      registry.live.end());
+}
+
+std::uint64_t jaco_profile::Histogram::Count() const {
+  std::uint64_t count = 0;
+  for (const std::uint64_t bucket : buckets) {
+    count += bucket;
+  }
+  return count;
+}
+
+double jaco_profile::Histogram::MeanNs() const {
+  const std::uint64_t count = Count();
+  return count > 0 ? static_cast<double>(total_ns) / static_cast<double>(count) : 0.0;
+}
+
+double jaco_profile::Histogram::PercentileNs(double percent) const {
+  const std::uint64_t count = Count();
+  if (count == 0) {
+    return 0.0;
+  }
+  const double rank = percent / 100.0 * static_cast<double>(count);
+  std::uint64_t seen = 0;
+  for (int b = 0; b < kBuckets; ++b) {
+    seen += buckets[b];
+    if (static_cast<double>(seen) >= rank && buckets[b] != 0) {
+      return static_cast<double>(1ULL << b);
+    }
+  }
+  return static_cast<double>(1ULL << (kBuckets - 1));
+}
+
+const char* jaco_profile::PhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::StartRound:
+      return "StartRound";
+    case Phase::InitialBets:
+      return "InitialBets";
+    case Phase::Insurance:
+      return "Insurance";
+    case Phase::PlayerDecisions:
+      return "PlayerDecisions";
+    case Phase::DealerDraw:
+      return "DealerDraw";
+    case Phase::Settlement:
+      return "Settlement";
+    default:
+      return "Unknown";
+  }
+}
+
+jaco_profile::Snapshot jaco_profile::Collect() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  Snapshot snapshot = registry.retired;
+  for (const Recorder* live : registry.live) {
+    const Recorder& recorder = *live;
+    for (int p = 0; p < kPhases; ++p) {
+      snapshot[p].total_ns += recorder.total_ns[p].load(std::memory_order_relaxed);
+      for (int b = 0; b < kBuckets; ++b) {
+        snapshot[p].buckets[b] += recorder.buckets[p][b].load(std::memory_order_relaxed);
+      }
+    }
+  }
+  return snapshot;
+}
+
+void jaco_profile::Report(std::ostream& out, const Snapshot& snapshot) {
+  if (!kEnabled) {
+    out << "Phase timers compiled out (build with JACO_PROFILE_PHASES=1)\n";
+    return;
+  }
+  std::uint64_t total = 0;
+  for (const auto& histogram : snapshot) {
+    total += histogram.total_ns;
+  }
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << std::left << std::setw(16) << "Phase" << std::right << std::setw(14) << "count"
+      << std::setw(11) << "mean ns" << std::setw(11) << "p50 ns" << std::setw(11)
+      << "p99 ns" << std::setw(8) << "share" << "\n";
+  out << std::fixed << std::setprecision(1);
+  for (int p = 0; p < kPhases; ++p) {
+    const Histogram& histogram = snapshot[p];
+    const double share = total > 0 ? 100.0 * static_cast<double>(histogram.total_ns) /
+                                         static_cast<double>(total)
+                                   : 0.0;
+    out << std::left << std::setw(16) << PhaseName(static_cast<Phase>(p)) << std::right
+        << std::setw(14) << histogram.Count() << std::setw(11) << histogram.MeanNs()
+        << std::setw(11) << histogram.PercentileNs(50.0) << std::setw(11)
+        << histogram.PercentileNs(99.0) << std::setw(7) << share << "%\n";
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void jaco_profile::StartReporting(double seconds, std::ostream& out) {
+  if (!kEnabled || seconds <= 0.0) {
+    return;
+  }
+  StopReporting();
+  Reporter& reporter = GetReporter();
+  reporter.stop = false;
+  const auto period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(seconds));
+  reporter.thread = std::thread([&reporter, &out, period] {
+    std::unique_lock<std::mutex> lock(reporter.mutex);
+    while (!reporter.wake.wait_for(lock, period, [&reporter] { return reporter.stop; })) {
+      lock.unlock();
+      Report(out, Collect());
+      out.flush();
+      lock.lock();
+    }
+  });
+}
+
+void jaco_profile::StopReporting() {
+  Reporter& reporter = GetReporter();
+  if (!reporter.thread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(reporter.mutex);
+    reporter.stop = true;
+  }
+  reporter.wake.notify_one();
+  reporter.thread.join();
+}
@@ -0,0 +1,228 @@
+#pragma once
+#ifndef JACO_PROFILE_H
+#define JACO_PROFILE_H
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief Compiles the round phase timers in when nonzero (off by default).
+ *
+ * With 0 every @ref JACO_PROFILE_BEGIN, @ref JACO_PROFILE_MARK and
+ * @ref JACO_PROFILE_END expands to nothing and the round loop is unchanged.
+ */
+#ifndef JACO_PROFILE_PHASES
+#define JACO_PROFILE_PHASES 0
+#endif
+
+/**
+ * @class jaco_profile
+ * @brief Time spent in each phase of a round, as per-thread histograms.
+ *
+ * A round is timed as a chain of laps: @ref BeginRound reads the clock and
+ * every @ref Mark charges the time since the previous reading to one phase.
+ * Each thread owns its histograms (powers of two of nanoseconds) and is
+ * their only writer, so recording is a clock read and two relaxed stores,
+ * with no lock or read-modify-write. @ref Collect sums the histograms of all
+ * threads, live or finished, at any time, and @ref StartReporting prints
+ * them periodically.
+ */
+class jaco_profile {
+public:
+    /**
+     * @enum Phase
+     * @brief Timed sections of a round, in the order they run.
+     */
+    enum class Phase : int {
+        StartRound = 0,   ///< Shoe reshuffle if due and the initial deal
+        InitialBets,      ///< Every seat's initial bet
+        Insurance,        ///< Insurance offers when the dealer shows an ace
+        PlayerDecisions,  ///< Decide and apply actions until every hand stands
+        DealerDraw,       ///< Dealer draws to the stop total
+        Settlement,       ///< Results and payouts
+        Count
+    };
+
+    static constexpr int kPhases = static_cast<int>(Phase::Count);
+
+    /** @brief Histogram buckets; bucket b holds durations below 2^b ns. */
+    static constexpr int kBuckets = 40;
+
+    /** @brief Checks whether the timers are compiled in. */
+    static constexpr bool kEnabled = JACO_PROFILE_PHASES != 0;
+
+    /**
+     * @struct Histogram
+     * @brief Durations of one phase summed over threads.
+     */
+    struct Histogram {
+        std::uint64_t total_ns = 0;
+        std::array<std::uint64_t, kBuckets> buckets{};
+
+        std::uint64_t Count() const;
+        double MeanNs() const;
+
+        /**
+         * @brief Upper bound of the bucket holding the @p percent percentile.
+         */
+        double PercentileNs(double percent) const;
+    };
+
+    /** @brief Histograms of every phase. */
+    using Snapshot = std::array<Histogram, kPhases>;
+
+    static const char* PhaseName(Phase phase);
+
+    /**
+     * @brief Starts timing a round on the calling thread.
+     */
+    static void BeginRound() {
+        Recorder& recorder = Local();
+        recorder.active = true;
+        if (recorder.observer != nullptr) {
+            recorder.observer(Phase::StartRound, true);
+        }
+        recorder.last = Clock::now();
+    }
+
+    /**
+     * @brief Charges the time since the previous mark to @p phase.
+     *
+     * Ignored outside a round, so shared code (e.g. the table's settlement
+     * called by a bot) can mark phases unconditionally.
+     */
+    static void Mark(Phase phase) {
+        Recorder& recorder = Local();
+        if (!recorder.active) {
+            return;
+        }
+        const Clock::time_point now = Clock::now();
+        recorder.Add(phase, now - recorder.last);
+        recorder.last = now;
+        if (recorder.observer != nullptr) {
+            // Keep the observer's own cost out of the next phase.
+            recorder.observer(phase, false);
+            recorder.last = Clock::now();
+        }
+    }
+
+    /**
+     * @brief Charges the last phase of the round and stops timing.
+     */
+    static void EndRound(Phase phase) {
+        Mark(phase);
+        Local().active = false;
+    }
+
+    /**
+     * @brief Callback run at the phase boundaries of the calling thread.
+     *
+     * Called with (StartRound, true) when a round begins and with
+     * (phase, false) when @p phase ends; used by @ref jaco_perf to split
+     * hardware counters by phase.
+     */
+    using Observer = void (*)(Phase phase, bool round_start);
+
+    /**
+     * @brief Installs @p observer on the calling thread (nullptr = none).
+     */
+    static void SetObserver(Observer observer) { Local().observer = observer; }
+
+    /**
+     * @brief Sums the histograms of every thread that has recorded a phase.
+     */
+    static Snapshot Collect();
+
+    /**
+     * @brief Prints count, mean, p50, p99 and share of each phase.
+     */
+    static void Report(std::ostream& out, const Snapshot& snapshot);
+
+    /**
+     * @brief Prints @ref Collect to @p out every @p seconds until
+     * @ref StopReporting. Does nothing when the timers are compiled out.
+     */
+    static void StartReporting(double seconds, std::ostream& out);
+
+    /**
+     * @brief Stops the periodic report started by @ref StartReporting.
+     */
+    static void StopReporting();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Histograms written by one thread, registered for @ref Collect.
+     */
+    struct Recorder {
+        Recorder();
+        ~Recorder();
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+
+        void Add(Phase phase, Clock::duration elapsed) {
+            const std::uint64_t ns = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            const int p = static_cast<int>(phase);
+            Bump(buckets[p][Bucket(ns)], 1);
+            Bump(total_ns[p], ns);
+        }
+
+        /** @brief Single-writer increment: readers see old or new, never torn. */
+        static void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount,
+                          std::memory_order_relaxed);
+        }
+
+        static int Bucket(std::uint64_t ns) {
+            int bucket = 0;
+#if defined(__GNUC__) || defined(__clang__)
+            bucket = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+#else
+            while (ns != 0) {
+                ns >>= 1;
+                ++bucket;
+            }
+#endif
+            return bucket < kBuckets ? bucket : kBuckets - 1;
+        }
+
+        std::array<std::array<std::atomic<std::uint64_t>, kBuckets>, kPhases> buckets{};
+        std::array<std::atomic<std::uint64_t>, kPhases> total_ns{};
+        Clock::time_point last;
+        bool active = false;
+        Observer observer = nullptr;
+    };
+
+    static Recorder& Local() {
+        thread_local Recorder recorder;
+        return recorder;
+    }
+
+    /** @brief Live recorders and the totals of finished threads. */
+    struct Registry;
+    static Registry& GetRegistry();
+};
+
+/**
+ * @name Phase timer macros
+ * @brief Round instrumentation, e.g. `JACO_PROFILE_MARK(InitialBets);`.
+ *
+ * Expand to nothing unless @ref JACO_PROFILE_PHASES is set.
+ */
+///@{
+#if JACO_PROFILE_PHASES
+#define JACO_PROFILE_BEGIN() jaco_profile::BeginRound()
+#define JACO_PROFILE_MARK(phase) jaco_profile::Mark(jaco_profile::Phase::phase)
+#define JACO_PROFILE_END(phase) jaco_profile::EndRound(jaco_profile::Phase::phase)
+#else
+#define JACO_PROFILE_BEGIN() ((void)0)
+#define JACO_PROFILE_MARK(phase) ((void)0)
+#define JACO_PROFILE_END(phase) ((void)0)
+#endif
+///@}
+
+#endif // JACO_PROFILE_H
@@ -0,0 +1,123 @@
+#include "NewBJ/jaco_replay.h"
+#include "NewBJ/jaco_game.h"
+#include "NewBJ/jaco_player.h"
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+void jaco_replay::Results::Merge(const Results& other) {
+  rounds += other.rounds;
+  recorded_net += other.recorded_net;
+  replayed_net += other.replayed_net;
+  changed_rounds += other.changed_rounds;
+  approximate_rounds += other.approximate_rounds;
+  difference.Merge(other.difference);
+}
+
+jaco_replay::jaco_replay(const jaco_history_reader& history, const Config& config)
+    : history_(history), config_(config) {
+  if (config_.batch_rounds < 1) {
+    config_.batch_rounds = 1;
+  }
+  threads_ = config_.threads;
+  if (threads_ <= 0) {
+    threads_ = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  const long long batches =
+      (static_cast<long long>(history_.Count()) + config_.batch_rounds - 1) /
+      config_.batch_rounds;
+  threads_ = static_cast<int>(std::min<long long>(std::max(threads_, 1),
+                                                  std::max(batches, 1LL)));
+}
+
+/**
+ * @brief Restores each recorded round (shoe and bankrolls), plays it and
+ * compares every seat's money change with the recording.
+ */
+void jaco_replay::RunWorker(Results& out) {
+  jaco_rules rules(history_.Mode());
+  rules.SetPenetration(history_.Penetration());
+  const int seats = history_.Seats();
+  std::vector<jaco_player> players;
+  players.reserve(ITable::kMaxPlayers);
+  for (int i = 0; i < seats; ++i) {
+    players.emplace_back(i, rules);
+    players.back().SetStrategy(config_.strategy);
+  }
+  jaco_game game(rules, players);
+
+  Results results;
+  std::array<long long, ITable::kMaxPlayers> before{};
+  std::array<long long, ITable::kMaxPlayers> recorded{};
+  const long long count = static_cast<long long>(history_.Count());
+
+  jaco_dispatch_rules(rules, [&](const auto& static_rules) {
+    while (true) {
+      const long long first = cursor_.fetch_add(config_.batch_rounds);
+      if (first >= count) {
+        break;
+      }
+      const long long last = std::min(first + config_.batch_rounds, count);
+      for (long long i = first; i < last; ++i) {
+        const auto round = history_.Round(static_cast<std::size_t>(i));
+        const auto& header = round.Header();
+        for (int s = 0; s < seats; ++s) {
+          const auto& seat = round.Seat(s);
+          long long stake = seat.insurance;
+          for (int h = 0; h < seat.hand_count; ++h) {
+            stake += seat.hands[h].bet;
+          }
+          recorded[s] = seat.payout - stake;
+          before[s] = seat.money - recorded[s];
+          players[s].player_money = static_cast<int>(before[s]);
+        }
+
+        Cards::State state;
+        state.round = header.round;
+        state.shuffle_round = header.shuffle_round;
+        state.discard_round = header.discard_round;
+        state.position = header.shoe_position;
+        state.discard_start = header.discard_start;
+        game.RestoreShoe(header.seed, header.table_id, state);
+        game.PlayRound(static_rules);
+
+        bool changed = false;
+        long long round_difference = 0;
+        for (int s = 0; s < seats; ++s) {
+          const long long replayed = players[s].player_money - before[s];
+          changed = changed || replayed != recorded[s];
+          round_difference += replayed - recorded[s];
+          results.recorded_net += recorded[s];
+          results.replayed_net += replayed;
+        }
+        results.difference.Add(static_cast<double>(round_difference) / seats);
+        results.changed_rounds += changed ? 1 : 0;
+        if (header.flags & jaco_history_format::kShoeNotRestorable) {
+          ++results.approximate_rounds;
+        }
+        ++results.rounds;
+      }
+    }
+  });
+  out = results;
+}
+
+jaco_replay::Results jaco_replay::Run() {
+  cursor_.store(0);
+  std::vector<Results> partial(threads_);
+  std::vector<std::thread> workers;
+  workers.reserve(threads_);
+  for (int i = 0; i < threads_; ++i) {
+    workers.emplace_back(&jaco_replay::RunWorker, this, std::ref(partial[i]));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  Results merged;
+  for (const auto& results : partial) {
+    merged.Merge(results);
+  }
+  return merged;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#ifndef JACO_REPLAY_H
+#define JACO_REPLAY_H
+#include "NewBJ/jaco_history_reader.h"
+#include "NewBJ/jaco_rules.h"
+#include "NewBJ/jaco_stats.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class jaco_replay
+ * @brief Re-plays a recorded hand history with another strategy.
+ *
+ * The rules (game mode, penetration) are those stored in the history. Every
+ * record keeps the seed, table id, round and dealing position of its
+ * shoe, so the table rebuilds the exact card order of the recorded round
+ * (see @ref jaco_table::RestoreShoe) instead of drawing a new shuffle. Each
+ * seat starts the round with its recorded bankroll, the players use the
+ * replayed chart, and the outcome is compared seat by seat with the
+ * recording. Replaying with the recording's own chart reproduces every
+ * round, which makes the replay a regression check as well as a
+ * noise-free comparison.
+ *
+ * Records are handed out in batches through an atomic cursor and played on
+ * every core; each worker owns its rules, players and table.
+ */
+class jaco_replay {
+public:
+    /**
+     * @struct Config
+     * @brief Parameters of a replay.
+     */
+    struct Config {
+        const std::uint8_t* strategy = nullptr; ///< Chart entries of the replayed players (nullptr = built-in)
+        int threads = 0;                    ///< Worker threads (0 = hardware concurrency)
+        long long batch_rounds = 4096;      ///< Records claimed by a worker at a time
+    };
+
+    /**
+     * @struct Results
+     * @brief Comparison of the replay with the recording.
+     */
+    struct Results {
+        long long rounds = 0;
+        long long recorded_net = 0;    ///< Player money change in the recording
+        long long replayed_net = 0;    ///< Player money change in the replay
+        long long changed_rounds = 0;  ///< Rounds in which some seat ended differently
+        long long approximate_rounds = 0; ///< Rounds whose shoe could not be rebuilt exactly
+        jaco_stats difference;         ///< Replayed minus recorded EV per seat, one sample per round
+
+        /**
+         * @brief Adds another worker's totals to these.
+         */
+        void Merge(const Results& other);
+    };
+
+    /**
+     * @brief Prepares a replay of an open history.
+     * @param history Mapped history, kept open by the caller during @ref Run.
+     * @param config Replay parameters.
+     */
+    jaco_replay(const jaco_history_reader& history, const Config& config);
+
+    /**
+     * @brief Replays every record and returns the merged comparison.
+     */
+    Results Run();
+
+    /**
+     * @brief Gets the number of worker threads used by @ref Run.
+     */
+    int ThreadCount() const { return threads_; }
+
+private:
+    /**
+     * @brief Worker loop: claims batches until the history is exhausted.
+     */
+    void RunWorker(Results& out);
+
+    const jaco_history_reader& history_;
+    Config config_;
+    int threads_ = 1;
+
+    /** @brief Next record to hand out. */
+    std::atomic<long long> cursor_{0};
+};
+
+#endif // JACO_REPLAY_H
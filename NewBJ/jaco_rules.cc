@@ -22,3 +22,28 @@ jaco_rules::GameType jaco_rules::GetGameMode(){
 }
 
 
+
+const char* jaco_rules::ModeName(GameType game_type){
+    switch(game_type){
+        case GameType::ROUND:
+            return "round";
+        case GameType::EXTREME:
+            return "extreme";
+        case GameType::CLASSIC:
+        default:
+            return "classic";
+    }
+}
+
+bool jaco_rules::ParseMode(const std::string& text, GameType& game_type){
+    if (text == "classic" || text == "1") {
+        game_type = GameType::CLASSIC;
+    } else if (text == "round" || text == "2") {
+        game_type = GameType::ROUND;
+    } else if (text == "extreme" || text == "3") {
+        game_type = GameType::EXTREME;
+    } else {
+        return false;
+    }
+    return true;
+}
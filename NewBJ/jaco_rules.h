@@ -2,6 +2,7 @@
 #ifndef JACO_RULES_H
 #define JACO_RULES_H
 #include <iostream>
+#include <string>
 #include "Interface/irules.h"
 
 /**
@@ -10,8 +11,11 @@
  *
  * The class extends BaseRules and overrides several rule-related methods
  * depending on the game mode chosen by the user (Classic, Round, Extreme).
+ * It is final, so calls through a jaco_rules reference are not virtual; the
+ * simulation core is additionally compiled per mode through
+ * @ref jaco_dispatch_rules (see jaco_rules_policy.h).
  */
-class jaco_rules : public BaseRules{
+class jaco_rules final : public BaseRules{
 public:
     /**
      * @name Rule constants
@@ -27,6 +31,7 @@ public:
     static constexpr int kMaximumInitialBet  = 10000;   ///< Maximum allowed initial bet
     static constexpr int kDealerStop         = 17;      ///< Score at which the dealer stops dealing cards
     static constexpr int kInitialCards       = 2;       ///< Number of cards dealt initially to each player
+    static constexpr int kShoePenetration    = 75;      ///< Percentage of the shoe dealt before reshuffling
     ///@}
 
     /**
@@ -46,6 +51,40 @@ public:
         GameRules = GetGameMode();
     }
 
+    /**
+     * @brief Builds the rules for a known game mode without prompting.
+     *
+     * Used by non-interactive entry points such as the headless simulator.
+     *
+     * @param game_type The game mode to play.
+     */
+    explicit jaco_rules(GameType game_type) : GameRules(game_type) {}
+
+    /**
+     * @brief Gets the active game mode.
+     * @return GameType The mode these rules were built for.
+     */
+    GameType GetGameType() const { return GameRules; }
+
+    /**
+     * @brief Gets the command-line name of a game mode.
+     * @param game_type The game mode to name.
+     * @return const char* "classic", "round" or "extreme".
+     */
+    static const char* ModeName(GameType game_type);
+
+    /**
+     * @brief Parses a game mode given on the command line.
+     *
+     * Accepts the names returned by @ref ModeName and the menu numbers of
+     * @ref GetGameMode ("1", "2", "3").
+     *
+     * @param text The argument to parse.
+     * @param game_type Receives the mode when @p text is recognised.
+     * @return bool False if @p text names no game mode.
+     */
+    static bool ParseMode(const std::string& text, GameType& game_type);
+
     /**
      * @brief Asks the user to select a game mode.
      *
@@ -126,6 +165,18 @@ public:
      */
     int DealerStop() const override{ return kDealerStop; }
 
+    /**
+     * @brief Gets the shoe penetration (position of the cut card).
+     * @return int Percentage of the shoe dealt before it is reshuffled (default: 75)
+     */
+    int Penetration() const { return ShoePenetration; }
+
+    /**
+     * @brief Moves the cut card.
+     * @param penetration Percentage of the shoe dealt before reshuffling (1-100).
+     */
+    void SetPenetration(int penetration) { ShoePenetration = penetration; }
+
     ~jaco_rules() = default; 
 
 private:
@@ -136,6 +187,11 @@ private:
      * such as @ref GetWinPoint() and @ref NumberOfDecks().
      */
     GameType GameRules;
+
+    /**
+     * @brief Percentage of the shoe dealt before the cut card is reached.
+     */
+    int ShoePenetration = kShoePenetration;
 };
 
 
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef JACO_RULES_POLICY_H
+#define JACO_RULES_POLICY_H
+#include "NewBJ/jaco_rules.h"
+
+/**
+ * @struct jaco_static_rules
+ * @brief Rule set whose thresholds are compile-time constants.
+ *
+ * Exposes the same accessors as @ref jaco_rules (GetWinPoint, DealerStop,
+ * NumberOfDecks), so every templated hot path accepts either one. With a
+ * static rule set the win point and dealer stop fold into immediates and the
+ * rule switch disappears from the inner loops.
+ *
+ * New rule variants only need a new alias (and an explicit instantiation in
+ * jaco_table.cc and jaco_game.cc).
+ *
+ * @tparam WinPoint Score needed to win.
+ * @tparam Decks Number of decks in the shoe.
+ * @tparam Stop Score at which the dealer stops drawing.
+ */
+template <int WinPoint, int Decks, int Stop = jaco_rules::kDealerStop>
+struct jaco_static_rules {
+    static constexpr int kWinPoint   = WinPoint;
+    static constexpr int kDecks      = Decks;
+    static constexpr int kDealerStop = Stop;
+
+    static constexpr int GetWinPoint() { return kWinPoint; }
+    static constexpr int NumberOfDecks() { return kDecks; }
+    static constexpr int DealerStop() { return kDealerStop; }
+};
+
+/// @name Built-in game modes
+///@{
+using jaco_classic_rules = jaco_static_rules<21, 1>;  ///< jaco_rules::GameType::CLASSIC
+using jaco_round_rules   = jaco_static_rules<20, 1>;  ///< jaco_rules::GameType::ROUND
+using jaco_extreme_rules = jaco_static_rules<25, 2>;  ///< jaco_rules::GameType::EXTREME
+///@}
+
+/**
+ * @brief Best total of a hand: as many aces as possible count as 11 without
+ * going over the win point (several can with a win point of 25).
+ *
+ * @param hard_total Total with every ace counted as 1.
+ * @param aces Number of aces in the hand.
+ * @param win_point Score needed to win.
+ * @return int The hand score.
+ */
+constexpr int jaco_best_total(int hard_total, int aces, int win_point) {
+    const int headroom = win_point - hard_total;
+    if (aces == 0 || headroom < 10) {
+        return hard_total;
+    }
+    const int upgrades = headroom / 10 < aces ? headroom / 10 : aces;
+    return hard_total + 10 * upgrades;
+}
+
+/**
+ * @brief Best total of a hand under a rule set.
+ * @param rules Static rule set or @ref jaco_rules.
+ */
+template <class Rules>
+constexpr int jaco_best_total(int hard_total, int aces, const Rules& rules) {
+    return jaco_best_total(hard_total, aces, rules.GetWinPoint());
+}
+
+/**
+ * @brief Calls @p f once with the static rule set matching @p rules.
+ *
+ * This is the runtime dispatch layer: the switch on the game mode runs once,
+ * and everything called from @p f is compiled for that mode's constants.
+ *
+ * @param rules Runtime rules chosen at startup.
+ * @param f Generic callable taking the rule set by const reference.
+ * @return Whatever @p f returns.
+ */
+template <class F>
+decltype(auto) jaco_dispatch_rules(const jaco_rules& rules, F&& f) {
+    switch (rules.GetGameType()) {
+        case jaco_rules::GameType::ROUND:
+            return f(jaco_round_rules{});
+        case jaco_rules::GameType::EXTREME:
+            return f(jaco_extreme_rules{});
+        case jaco_rules::GameType::CLASSIC:
+        default:
+            return f(jaco_classic_rules{});
+    }
+}
+
+#endif // JACO_RULES_POLICY_H
@@ -0,0 +1,398 @@
+#include "NewBJ/jaco_simulator.h"
+#include "NewBJ/jaco_game.h"
+#include "NewBJ/jaco_history_writer.h"
+#include "NewBJ/jaco_perf.h"
+#include "NewBJ/jaco_player.h"
+#include "NewBJ/jaco_rng.h"
+#include <array>
+#include <thread>
+
+namespace {
+
+  /**
+   * @brief Adds one settled round to the worker's totals.
+   */
+  void CountRound(const ITable::RoundResults& info,
+                  jaco_simulator::Results& results) {
+    for (int p = 0; p < static_cast<int>(info.hand_counts.size()); ++p) {
+      for (int h = 0; h < info.hand_counts[p]; ++h) {
+        ++results.hands;
+        switch (info.Winner(p, h)) {
+          case ITable::RoundEndInfo::BetResult::Win:  ++results.wins;   break;
+          case ITable::RoundEndInfo::BetResult::Lose: ++results.losses; break;
+          default:                                    ++results.ties;   break;
+        }
+      }
+    }
+    results.dealer_net += info.croupier_money_delta;
+  }
+
+}  // namespace
+
+void jaco_simulator::Results::Merge(const Results& other) {
+  sessions += other.sessions;
+  rounds += other.rounds;
+  hands += other.hands;
+  wins += other.wins;
+  losses += other.losses;
+  ties += other.ties;
+  player_net += other.player_net;
+  dealer_net += other.dealer_net;
+  steals += other.steals;
+  session_ev.Merge(other.session_ev);
+  round_ev.Merge(other.round_ev);
+  if (seat_ev.size() < other.seat_ev.size()) {
+    seat_ev.resize(other.seat_ev.size());
+  }
+  for (size_t i = 0; i < other.seat_ev.size(); ++i) {
+    seat_ev[i].Merge(other.seat_ev[i]);
+  }
+  converged = converged || other.converged;
+  timed_out = timed_out || other.timed_out;
+  if (strategies.size() < other.strategies.size()) {
+    strategies.resize(other.strategies.size());
+  }
+  for (size_t i = 0; i < other.strategies.size(); ++i) {
+    strategies[i].player_net += other.strategies[i].player_net;
+    strategies[i].round_ev.Merge(other.strategies[i].round_ev);
+    strategies[i].difference.Merge(other.strategies[i].difference);
+    auto& seats = strategies[i].seat_ev;
+    if (seats.size() < other.strategies[i].seat_ev.size()) {
+      seats.resize(other.strategies[i].seat_ev.size());
+    }
+    for (size_t s = 0; s < other.strategies[i].seat_ev.size(); ++s) {
+      seats[s].Merge(other.strategies[i].seat_ev[s]);
+    }
+  }
+}
+
+/**
+ * @brief Sizes the worker pool and deals sessions in contiguous blocks.
+ * @param config Run parameters.
+ */
+jaco_simulator::jaco_simulator(const Config& config) : config_(config) {
+  if (config_.seed == 0) {
+    config_.seed = jaco_rng::RandomSeed();
+  }
+  stopping_ = config_.target_half_width > 0.0 || config_.time_budget > 0.0;
+  int threads = config_.threads;
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  if (threads <= 0) {
+    threads = 1;
+  }
+  if (config_.sessions > 0 && threads > config_.sessions) {
+    threads = static_cast<int>(config_.sessions);
+  }
+
+  queues_.reserve(threads);
+  for (int i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  for (long long session = 0; session < config_.sessions; ++session) {
+    const long long worker = session * threads / config_.sessions;
+    queues_[static_cast<size_t>(worker)]->sessions.push_back(session);
+  }
+}
+
+/**
+ * @brief Pops from the back of the worker's own queue, otherwise steals from
+ * the front of the next non-empty queue.
+ */
+bool jaco_simulator::NextSession(int worker, long long& session,
+                                 bool& stolen) {
+  {
+    auto& own = *queues_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.sessions.empty()) {
+      session = own.sessions.back();
+      own.sessions.pop_back();
+      stolen = false;
+      return true;
+    }
+  }
+
+  const int count = static_cast<int>(queues_.size());
+  for (int offset = 1; offset < count; ++offset) {
+    auto& victim = *queues_[(worker + offset) % count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.sessions.empty()) {
+      session = victim.sessions.front();
+      victim.sessions.pop_front();
+      stolen = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Stops every worker once the merged interval is narrow enough or the
+ * deadline has passed.
+ */
+void jaco_simulator::Publish(const jaco_stats& pending) {
+  std::lock_guard<std::mutex> lock(progress_mutex_);
+  progress_.Merge(pending);
+  if (stop_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (config_.target_half_width > 0.0 && progress_.Count() >= config_.min_rounds &&
+      progress_.HalfWidth() <= config_.target_half_width) {
+    converged_ = true;
+    stop_.store(true, std::memory_order_relaxed);
+  } else if (config_.time_budget > 0.0 &&
+             std::chrono::steady_clock::now() >= deadline_) {
+    timed_out_ = true;
+    stop_.store(true, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Plays sessions until no work is left anywhere or a stopping rule is met.
+ */
+void jaco_simulator::RunWorker(int worker, Results& out) {
+  // Worker-owned state: nothing below is visible to other threads. Totals are
+  // kept on the stack and published once to avoid false sharing.
+  const jaco_perf::ThreadScope counters(config_.perf_counters, config_.perf_phases);
+  jaco_rules rules(config_.mode);
+  rules.SetPenetration(config_.penetration);
+  Results results;
+  results.strategies.resize(config_.compare.size());
+  for (auto& strategy : results.strategies) {
+    strategy.seat_ev.resize(static_cast<size_t>(config_.players));
+  }
+  results.seat_ev.resize(static_cast<size_t>(config_.players));
+  std::vector<jaco_player> players;
+  players.reserve(ITable::kMaxPlayers);
+  std::array<long long, ITable::kMaxPlayers> before{};
+  jaco_stats pending;
+  // Batches this worker's records; the last batch is handed over on exit.
+  std::unique_ptr<jaco_history_recorder> recorder;
+  if (config_.history != nullptr) {
+    recorder = std::make_unique<jaco_history_recorder>(*config_.history);
+  }
+
+  long long session = 0;
+  bool stolen = false;
+  while (!Stopped() && NextSession(worker, session, stolen)) {
+    if (stolen) {
+      ++results.steals;
+    }
+    if (!config_.compare.empty()) {
+      PlayPairedSession(session, rules, results, pending, recorder.get());
+      continue;
+    }
+
+    players.clear();
+    for (int i = 0; i < config_.players; ++i) {
+      players.emplace_back(i, rules);
+      players.back().SetStrategy(config_.strategy);
+    }
+
+    jaco_game game(rules, players, config_.seed, static_cast<std::uint64_t>(session));
+    game.SetRecorder(recorder.get());
+    auto play_session = [&](auto&& play_round) {
+      while (!Stopped() && !game.IsGameOver() &&
+             (config_.rounds_per_session == 0 ||
+              game.RoundsPlayed() < config_.rounds_per_session)) {
+        for (int i = 0; i < config_.players; ++i) {
+          before[i] = players[i].player_money;
+        }
+        play_round();
+        CountRound(game.LastRound(), results);
+
+        // RoundResults::player_money_delta is the payout; the bankroll change
+        // also accounts for the stakes placed during the round.
+        long long round_net = 0;
+        for (int i = 0; i < config_.players; ++i) {
+          const long long delta = players[i].player_money - before[i];
+          results.seat_ev[i].Add(static_cast<double>(delta));
+          round_net += delta;
+        }
+        const double round_ev = static_cast<double>(round_net) / config_.players;
+        results.round_ev.Add(round_ev);
+        if (stopping_) {
+          pending.Add(round_ev);
+          if (pending.Count() == kPublishRounds) {
+            Publish(pending);
+            pending = jaco_stats();
+          }
+        }
+      }
+    };
+    if (config_.virtual_dispatch) {
+      play_session([&] { game.PlayRoundVirtual(); });
+    } else {
+      // Pick the compiled rule set once for the whole session.
+      jaco_dispatch_rules(rules, [&](const auto& static_rules) {
+        play_session([&] { game.PlayRound(static_rules); });
+      });
+    }
+
+    long long session_net = 0;
+    for (const auto& player : players) {
+      session_net += player.player_money - rules.InitialPlayerMoney();
+    }
+    const double seat_rounds =
+        static_cast<double>(game.RoundsPlayed()) * config_.players;
+    const double session_ev = seat_rounds > 0 ? session_net / seat_rounds : 0.0;
+    results.session_ev.Add(session_ev);
+    results.player_net += session_net;
+    results.rounds += game.RoundsPlayed();
+    ++results.sessions;
+  }
+  out = results;
+}
+
+/**
+ * @brief Shuffles once per shoe and hands a copy of it to every table at the
+ * start of each round.
+ */
+void jaco_simulator::PlayPairedSession(long long session, const jaco_rules& rules,
+                                       Results& results, jaco_stats& pending,
+                                       jaco_history_recorder* recorder) {
+  const size_t count = config_.compare.size();
+  std::vector<std::vector<jaco_player>> seats(count);
+  std::vector<std::unique_ptr<jaco_game>> games;
+  games.reserve(count);
+  for (size_t s = 0; s < count; ++s) {
+    seats[s].reserve(ITable::kMaxPlayers);
+    for (int i = 0; i < config_.players; ++i) {
+      seats[s].emplace_back(i, rules);
+      seats[s].back().SetStrategy(config_.compare[s]);
+    }
+    games.push_back(std::make_unique<jaco_game>(rules, seats[s]));
+  }
+  // Each round's shoe state is copied into the table, so chart 1's records
+  // replay like those of an unpaired session.
+  games[0]->SetRecorder(recorder);
+
+  // Seeded like the table of an unpaired session, so the first chart deals
+  // exactly the cards it would have been dealt alone until the tables drift.
+  Cards shoe(rules.NumberOfDecks(), rules.Penetration());
+  shoe.SetSeed(config_.seed, static_cast<std::uint64_t>(session));
+  shoe.shuffleCards();
+
+  auto bankroll = [&](size_t s) {
+    long long money = 0;
+    for (const auto& player : seats[s]) {
+      money += player.player_money;
+    }
+    return money;
+  };
+  std::array<long long, ITable::kMaxPlayers> seat_before{};
+  auto any_over = [&] {
+    for (const auto& game : games) {
+      if (game->IsGameOver()) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  long long rounds = 0;
+  auto play_session = [&](auto&& play_round) {
+    while (!Stopped() && !any_over() &&
+           (config_.rounds_per_session == 0 ||
+            rounds < config_.rounds_per_session)) {
+      shoe.BeginRound();
+      size_t furthest = 0;
+      double reference = 0.0;
+      double difference = 0.0;
+      for (size_t s = 0; s < count; ++s) {
+        jaco_game& game = *games[s];
+        const long long before = bankroll(s);
+        for (int i = 0; i < config_.players; ++i) {
+          seat_before[i] = seats[s][i].player_money;
+        }
+        game.LoadShoe(shoe);
+        play_round(game);
+        const double ev =
+            static_cast<double>(bankroll(s) - before) / config_.players;
+        results.strategies[s].round_ev.Add(ev);
+        for (int i = 0; i < config_.players; ++i) {
+          const double delta =
+              static_cast<double>(seats[s][i].player_money - seat_before[i]);
+          results.strategies[s].seat_ev[i].Add(delta);
+          if (s == 0) {
+            results.seat_ev[i].Add(delta);
+          }
+        }
+        if (s == 0) {
+          // The unpaired statistics follow the first chart.
+          reference = ev;
+          CountRound(game.LastRound(), results);
+          results.round_ev.Add(ev);
+        } else {
+          difference = ev - reference;
+          results.strategies[s].difference.Add(difference);
+        }
+        if (game.Table().Shoe().Position() >
+            games[furthest]->Table().Shoe().Position()) {
+          furthest = s;
+        }
+      }
+      // Continue after the longest round so no table sees a card twice.
+      shoe = games[furthest]->Table().Shoe();
+      ++rounds;
+      if (stopping_) {
+        // A single chart has nothing to difference against; follow its EV
+        // like an unpaired run so the target and the deadline still apply.
+        pending.Add(count > 1 ? difference : reference);
+        if (pending.Count() == kPublishRounds) {
+          Publish(pending);
+          pending = jaco_stats();
+        }
+      }
+    }
+  };
+  if (config_.virtual_dispatch) {
+    play_session([](jaco_game& game) { game.PlayRoundVirtual(); });
+  } else {
+    jaco_dispatch_rules(rules, [&](const auto& static_rules) {
+      play_session([&](jaco_game& game) { game.PlayRound(static_rules); });
+    });
+  }
+
+  const long long initial =
+      static_cast<long long>(rules.InitialPlayerMoney()) * config_.players;
+  for (size_t s = 0; s < count; ++s) {
+    results.strategies[s].player_net += bankroll(s) - initial;
+  }
+  const long long session_net = bankroll(0) - initial;
+  const double seat_rounds = static_cast<double>(rounds) * config_.players;
+  const double session_ev = seat_rounds > 0 ? session_net / seat_rounds : 0.0;
+  results.session_ev.Add(session_ev);
+  results.player_net += session_net;
+  results.rounds += rounds;
+  ++results.sessions;
+}
+
+/**
+ * @brief Starts one thread per worker, waits for all of them and merges.
+ */
+jaco_simulator::Results jaco_simulator::Run() {
+  const int count = ThreadCount();
+  deadline_ = std::chrono::steady_clock::now() +
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(config_.time_budget));
+  std::vector<Results> partial(count);
+  std::vector<std::thread> workers;
+  workers.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    workers.emplace_back(&jaco_simulator::RunWorker, this, i,
+                         std::ref(partial[i]));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  Results merged;
+  for (const auto& results : partial) {
+    merged.Merge(results);
+  }
+  merged.converged = converged_;
+  merged.timed_out = timed_out_;
+  return merged;
+}
@@ -0,0 +1,211 @@
+#pragma once
+#ifndef JACO_SIMULATOR_H
+#define JACO_SIMULATOR_H
+#include "NewBJ/jaco_rules.h"
+#include "NewBJ/jaco_stats.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class jaco_history_writer;
+class jaco_history_recorder;
+
+/**
+ * @class jaco_simulator
+ * @brief Multi-threaded Monte Carlo driver that plays independent sessions.
+ *
+ * Each worker thread owns its own @ref jaco_rules, players and table, so no
+ * game state is shared between threads. Sessions are dealt to per-worker
+ * queues up front; a worker that empties its queue steals pending sessions
+ * from the others, which keeps every core busy even though sessions end at
+ * different times (see @ref jaco_game::IsGameOver).
+ *
+ * Session @e n always plays on table id @e n of the run's master seed, so the
+ * totals are identical for a given seed whatever the thread count.
+ *
+ * With @ref Config::compare set, every session seats one table per chart and
+ * deals all of them each round from a single shuffled shoe (common random
+ * numbers): the tables see the same cards while each keeps its own players
+ * and bankrolls. The per-round EV difference against the first chart is then
+ * free of most of the card noise, so far fewer rounds separate two strategies
+ * than with independent runs.
+ *
+ * Setting @ref Config::target_half_width or @ref Config::time_budget turns
+ * the session count into an upper bound: workers publish their running EV
+ * statistics every few thousand rounds, and all of them stop as soon as the
+ * merged confidence interval is narrow enough or the budget is spent.
+ */
+class jaco_simulator {
+public:
+    /**
+     * @struct Config
+     * @brief Parameters of a simulation run.
+     */
+    struct Config {
+        jaco_rules::GameType mode = jaco_rules::GameType::CLASSIC; ///< Rules to play
+        long long sessions = 1;             ///< Number of independent sessions
+        long long rounds_per_session = 0;   ///< Round limit per session (0 = until game over)
+        int players = 4;                    ///< Players seated at each table
+        int threads = 0;                    ///< Worker threads (0 = hardware concurrency)
+        int penetration = jaco_rules::kShoePenetration; ///< Percentage of the shoe dealt before reshuffling
+        std::uint64_t seed = 0;             ///< Master seed (0 = draw one at random)
+        bool virtual_dispatch = false;      ///< Play through the IPlayer/ITable interfaces (see @ref jaco_game::PlayRoundVirtual)
+        const std::uint8_t* strategy = nullptr; ///< Chart entries shared by every player (nullptr = built-in, see @ref jaco_player::SetStrategy)
+        std::vector<const std::uint8_t*> compare; ///< Paired mode: charts dealt the same shoes (nullptr = built-in)
+        double target_half_width = 0.0;     ///< Stop once the 95% CI of Results::round_ev (paired: last chart's difference, or its EV when it is the only one) is this narrow (0 = off)
+        long long min_rounds = 10000;       ///< Rounds required before the interval is trusted
+        double time_budget = 0.0;           ///< Wall-clock limit in seconds (0 = none)
+        jaco_history_writer* history = nullptr; ///< Open file receiving every round (paired: first chart's; nullptr = off)
+        bool perf_counters = false;         ///< Count hardware events on every worker (see @ref jaco_perf)
+        bool perf_phases = false;           ///< Also split them by round phase (JACO_PROFILE_PHASES builds)
+    };
+
+    /**
+     * @struct Results
+     * @brief Totals accumulated by the workers and merged at the end.
+     */
+    struct Results {
+        /**
+         * @struct Strategy
+         * @brief Paired-mode totals of one chart of Config::compare.
+         */
+        struct Strategy {
+            long long player_net = 0;  ///< Sum of final minus initial player money
+            jaco_stats round_ev;       ///< Player EV per seat, one sample per round
+            jaco_stats difference;     ///< Round EV minus the first chart's on the same cards
+            std::vector<jaco_stats> seat_ev;  ///< Player EV of each seat, one sample per round
+        };
+
+        long long sessions = 0;
+        long long rounds = 0;
+        long long hands = 0;
+        long long wins = 0;
+        long long losses = 0;
+        long long ties = 0;
+        long long player_net = 0;  ///< Sum of final minus initial player money
+        long long dealer_net = 0;  ///< Sum of dealer money deltas
+        long long steals = 0;      ///< Sessions taken from another worker's queue
+        jaco_stats session_ev;     ///< Player EV per round and seat, one sample per session
+        std::vector<Strategy> strategies;   ///< Paired mode, one per Config::compare entry
+        jaco_stats round_ev;                ///< Player EV per seat, one sample per round (seats averaged; paired: first chart)
+        std::vector<jaco_stats> seat_ev;    ///< Player EV of each seat, one sample per round (paired: first chart)
+        bool converged = false;             ///< Stopped at Config::target_half_width
+        bool timed_out = false;             ///< Stopped at Config::time_budget
+
+        /**
+         * @brief Adds another worker's totals to these.
+         * @param other Totals to add.
+         */
+        void Merge(const Results& other);
+    };
+
+    /**
+     * @brief Prepares a simulator for the given configuration.
+     * @param config Run parameters.
+     */
+    explicit jaco_simulator(const Config& config);
+
+    /**
+     * @brief Plays every session, or until a stopping rule is met, and
+     * returns the merged totals.
+     * @return Results Totals over all workers.
+     */
+    Results Run();
+
+    /**
+     * @brief Gets the number of worker threads used by @ref Run.
+     */
+    int ThreadCount() const { return static_cast<int>(queues_.size()); }
+
+    /**
+     * @brief Gets the master seed of the run (drawn at random if none was given).
+     */
+    std::uint64_t Seed() const { return config_.seed; }
+
+private:
+    /**
+     * @brief Pending sessions of one worker, padded to its own cache line.
+     */
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<long long> sessions;
+    };
+
+    /** @brief Rounds a worker plays between two publications of its statistics. */
+    static constexpr long long kPublishRounds = 4096;
+
+    /**
+     * @brief Takes the next session for @p worker, stealing if its queue is empty.
+     * @param worker Index of the calling worker.
+     * @param session Receives the session number.
+     * @param stolen Set to true when the session came from another queue.
+     * @return false once every queue is empty.
+     */
+    bool NextSession(int worker, long long& session, bool& stolen);
+
+    /**
+     * @brief Merges a worker's unpublished round EVs and checks the stopping rules.
+     * @param pending Samples gathered since the worker's last publication.
+     */
+    void Publish(const jaco_stats& pending);
+
+    /**
+     * @brief Checks whether the run has met a stopping rule.
+     */
+    bool Stopped() const { return stop_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Worker loop: owns its rules, players and table.
+     * @param worker Index of the worker.
+     * @param out Receives the worker's totals when it finishes.
+     */
+    void RunWorker(int worker, Results& out);
+
+    /**
+     * @brief Plays one paired session: every chart of Config::compare at its
+     * own table, all dealt from one shoe.
+     *
+     * The session ends as soon as any table is over so that every chart plays
+     * the same rounds. The shared counters of @p results (rounds, hands,
+     * player net, session, round and seat EV) follow the first chart.
+     *
+     * @param session Session number (table id of the shared shoe).
+     * @param rules Worker-owned rules.
+     * @param results Worker totals to add to.
+     * @param pending Worker's unpublished samples (see @ref Publish).
+     * @param recorder Worker's history recorder for the first chart's table (nullptr = none).
+     */
+    void PlayPairedSession(long long session, const jaco_rules& rules,
+                           Results& results, jaco_stats& pending,
+                           jaco_history_recorder* recorder);
+
+    /** @brief Run parameters. */
+    Config config_;
+
+    /** @brief One session queue per worker. */
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+    /** @brief True when a stopping rule is configured. */
+    bool stopping_ = false;
+
+    /** @brief Raised once for every worker to finish its current round and leave. */
+    std::atomic<bool> stop_{false};
+
+    /** @brief Guards the fields below. */
+    std::mutex progress_mutex_;
+
+    /** @brief Round EVs published by all workers so far. */
+    jaco_stats progress_;
+
+    /** @brief End of Config::time_budget. */
+    std::chrono::steady_clock::time_point deadline_;
+
+    bool converged_ = false;
+    bool timed_out_ = false;
+};
+
+#endif // JACO_SIMULATOR_H
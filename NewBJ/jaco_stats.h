@@ -0,0 +1,74 @@
+#pragma once
+#ifndef JACO_STATS_H
+#define JACO_STATS_H
+#include <cmath>
+
+/**
+ * @class jaco_stats
+ * @brief Running mean and variance of a sample (Welford's algorithm).
+ *
+ * Numerically stable in a single pass and constant memory. Two accumulators
+ * filled on different threads combine exactly with @ref Merge (Chan et al.),
+ * so workers can keep their own and publish once.
+ */
+class jaco_stats {
+public:
+    /**
+     * @brief Adds one observation.
+     */
+    void Add(double value) {
+        ++count_;
+        const double delta = value - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (value - mean_);
+    }
+
+    /**
+     * @brief Combines another accumulator into this one.
+     */
+    void Merge(const jaco_stats& other) {
+        if (other.count_ == 0) {
+            return;
+        }
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+        const long long count = count_ + other.count_;
+        const double delta = other.mean_ - mean_;
+        mean_ += delta * static_cast<double>(other.count_) / static_cast<double>(count);
+        m2_ += other.m2_ + delta * delta * static_cast<double>(count_) *
+               static_cast<double>(other.count_) / static_cast<double>(count);
+        count_ = count;
+    }
+
+    long long Count() const { return count_; }
+    double Mean() const { return mean_; }
+
+    /**
+     * @brief Unbiased sample variance (0 with fewer than two observations).
+     */
+    double Variance() const { return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0; }
+
+    double StdDev() const { return std::sqrt(Variance()); }
+
+    /**
+     * @brief Standard error of the mean.
+     */
+    double StdError() const {
+        return count_ > 0 ? std::sqrt(Variance() / static_cast<double>(count_)) : 0.0;
+    }
+
+    /**
+     * @brief Half-width of the normal confidence interval of the mean.
+     * @param z Quantile of the interval (1.96 = 95%).
+     */
+    double HalfWidth(double z = 1.96) const { return z * StdError(); }
+
+private:
+    long long count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;   ///< Sum of squared deviations from the mean
+};
+
+#endif // JACO_STATS_H
@@ -0,0 +1,72 @@
+#include "NewBJ/jaco_strategy_chart.h"
+#include "NewBJ/jaco_rules_policy.h"
+
+namespace {
+
+  /**
+   * @brief Whether the original split rules split a pair against an upcard.
+   * @param rank Point rank of the paired card.
+   * @param dealer_up Dealer upcard value, ace counted as 11.
+   */
+  bool HeuristicSplits(int rank, int dealer_up) {
+    const bool dealer_weak_2_7 = dealer_up >= 2 && dealer_up <= 7;
+    const bool dealer_weak_2_6 = dealer_up >= 2 && dealer_up <= 6;
+    switch (rank) {
+      case 0:  // A,A
+      case 7:  // 8,8
+        return true;
+      case 1:  // 2,2
+      case 2:  // 3,3
+      case 6:  // 7,7
+        return dealer_weak_2_7;
+      case 5:  // 6,6
+        return dealer_weak_2_6;
+      case 8:  // 9,9
+        return dealer_weak_2_6 || dealer_up == 8 || dealer_up == 9;
+      case 3:  // 4,4
+        return dealer_up == 5 || dealer_up == 6;
+      default:  // 5s and ten-valued cards are never split
+        return false;
+    }
+  }
+
+  ITable::Action HitBelow17(int score) {
+    return score < 17 ? ITable::Action::Hit : ITable::Action::Stand;
+  }
+
+}  // namespace
+
+jaco_strategy_chart jaco_strategy_chart::Heuristic(int win_point) {
+  jaco_strategy_chart chart;
+  for (int upcard = 0; upcard < kUpcards; ++upcard) {
+    const int dealer_up = upcard == 0 ? 11 : upcard + 1;
+    for (int total = 0; total < kTotals; ++total) {
+      chart.Set(HandClass::Hard, total, upcard, HitBelow17(total));
+      chart.Set(HandClass::Soft, total, upcard, HitBelow17(total));
+    }
+    for (int rank = 0; rank < Cards::kNumRanks; ++rank) {
+      const int points = rank == 0 ? 1 : rank + 1;
+      const int score = jaco_best_total(2 * points, rank == 0 ? 2 : 0,
+                                        win_point);
+      chart.Set(HandClass::Pair, rank, upcard,
+                HeuristicSplits(rank, dealer_up) ? ITable::Action::Split
+                                                 : HitBelow17(score));
+    }
+  }
+  return chart;
+}
+
+const jaco_strategy_chart& jaco_strategy_chart::Default(const jaco_rules& rules) {
+  static const jaco_strategy_chart classic = Heuristic(jaco_classic_rules::kWinPoint);
+  static const jaco_strategy_chart round = Heuristic(jaco_round_rules::kWinPoint);
+  static const jaco_strategy_chart extreme = Heuristic(jaco_extreme_rules::kWinPoint);
+  switch (rules.GetGameType()) {
+    case jaco_rules::GameType::ROUND:
+      return round;
+    case jaco_rules::GameType::EXTREME:
+      return extreme;
+    case jaco_rules::GameType::CLASSIC:
+    default:
+      return classic;
+  }
+}
@@ -0,0 +1,104 @@
+#pragma once
+#ifndef JACO_STRATEGY_CHART_H
+#define JACO_STRATEGY_CHART_H
+#include "Interface/itable.h"
+#include "NewBJ/cards.h"
+#include "NewBJ/jaco_rules.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * @class jaco_strategy_chart
+ * @brief Dense decision table indexed by (hand class, total, dealer upcard).
+ *
+ * Hard and soft rows are indexed by the hand score; pair rows by the point
+ * rank of the paired card (see @ref Cards::Rank). Upcards are point ranks
+ * too, so the ace is column 0 and every ten-valued card is column 9.
+ * Entries default to Stand.
+ *
+ * The entries are one byte each, class-major, so a chart can be used in
+ * place from a memory-mapped file (see @ref jaco_chart_file) through the
+ * static @ref Lookup overload.
+ */
+class jaco_strategy_chart {
+public:
+    /**
+     * @enum HandClass
+     * @brief Row group of a hand.
+     */
+    enum class HandClass : std::uint8_t {
+        Hard,  ///< No ace counted as 11
+        Soft,  ///< At least one ace counted as 11
+        Pair   ///< Two cards of the same value, before any split decision
+    };
+
+    static constexpr int kClasses  = 3;
+    static constexpr int kTotals   = 32;  ///< Scores 0..31 (pair rows use 0..9)
+    static constexpr int kUpcards  = Cards::kNumRanks;
+    static constexpr int kEntries  = kClasses * kTotals * kUpcards;
+
+    /**
+     * @brief Gets the action for a hand.
+     * @param hand_class Row group.
+     * @param total Hand score (pair rank for @ref HandClass::Pair).
+     * @param upcard Point rank of the dealer's face-up card.
+     */
+    ITable::Action Lookup(HandClass hand_class, int total, int upcard) const {
+        return Lookup(actions_.data(), hand_class, total, upcard);
+    }
+
+    /**
+     * @brief Gets the action for a hand from raw chart entries.
+     * @param entries @ref kEntries bytes laid out like @ref data.
+     */
+    static ITable::Action Lookup(const std::uint8_t* entries, HandClass hand_class,
+                                 int total, int upcard) {
+        return static_cast<ITable::Action>(entries[Index(hand_class, total, upcard)]);
+    }
+
+    /**
+     * @brief Sets the action for a hand.
+     */
+    void Set(HandClass hand_class, int total, int upcard, ITable::Action action) {
+        actions_[Index(hand_class, total, upcard)] = static_cast<std::uint8_t>(action);
+    }
+
+    /**
+     * @brief Gets the raw table (one byte per entry, class-major).
+     */
+    const std::uint8_t* data() const { return actions_.data(); }
+    std::uint8_t* data() { return actions_.data(); }
+
+    /**
+     * @brief Flat index of an entry; out-of-range totals clamp to the last row.
+     */
+    static constexpr int Index(HandClass hand_class, int total, int upcard) {
+        return (static_cast<int>(hand_class) * kTotals +
+                (total < 0 ? 0 : (total >= kTotals ? kTotals - 1 : total))) * kUpcards +
+               upcard;
+    }
+
+    /**
+     * @brief Chart equivalent to the original hand-written player logic.
+     *
+     * Splits aces and eights always, 2s, 3s and 7s against 2-7, 6s against
+     * 2-6, 9s against 2-6, 8 and 9 and 4s against 5-6; every other hand hits
+     * below 17 and stands otherwise.
+     *
+     * @param win_point Score needed to win (decides how a pair of aces counts).
+     */
+    static jaco_strategy_chart Heuristic(int win_point);
+
+    /**
+     * @brief Built-in chart used by players that were not given one.
+     *
+     * Built once per game mode from @ref Heuristic and shared by every player.
+     */
+    static const jaco_strategy_chart& Default(const jaco_rules& rules);
+
+private:
+    /** @brief One ITable::Action per entry. */
+    std::array<std::uint8_t, kEntries> actions_{};
+};
+
+#endif // JACO_STRATEGY_CHART_H
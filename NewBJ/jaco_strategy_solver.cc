@@ -0,0 +1,437 @@
+#include "NewBJ/jaco_strategy_solver.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+  using Composition = jaco_dealer_odds::Composition;
+  constexpr int kNumRanks = jaco_dealer_odds::kNumRanks;
+
+  /** @brief Bits per rank in a packed hand key. */
+  constexpr int kKeyBits = 5;
+
+  /** @brief Largest hand size used to find a representative of a chart row. */
+  constexpr int kMaxRepresentativeCards = 4;
+
+  /**
+   * @brief Player hand as a multiset with its running totals.
+   */
+  struct HandState {
+    Composition counts{};
+    int cards = 0;
+    int hard_total = 0;
+    int aces = 0;
+    std::uint64_t key = 0;  ///< counts packed at @ref kKeyBits bits per rank
+
+    HandState With(int rank) const {
+      HandState next = *this;
+      ++next.counts[rank];
+      ++next.cards;
+      next.hard_total += jaco_dealer_odds::RankPoints(rank);
+      next.aces += rank == 0 ? 1 : 0;
+      next.key += std::uint64_t(1) << (rank * kKeyBits);
+      return next;
+    }
+  };
+
+  /**
+   * @brief Memoized EVs of one upcard against a fixed shoe.
+   *
+   * @p base is the shoe without the upcard (and, for split hands, without
+   * the other half of the pair); the player's own cards are removed per call.
+   */
+  class UpcardAnalysis {
+  public:
+    UpcardAnalysis(int win_point, int dealer_stop, const Composition& base,
+                   int upcard)
+        : win_point_(win_point), upcard_(upcard), base_(base),
+          odds_(win_point, dealer_stop) {}
+
+    int Score(const HandState& hand) const {
+      return jaco_best_total(hand.hard_total, hand.aces, win_point_);
+    }
+
+    /**
+     * @brief Probability of drawing each rank next, given the hand.
+     * @return Number of cards left (0 when the shoe is empty).
+     */
+    int Remaining(const HandState& hand) const {
+      int remaining = 0;
+      for (int rank = 0; rank < kNumRanks; ++rank) {
+        remaining += base_[rank] - hand.counts[rank];
+      }
+      return remaining;
+    }
+
+    double Stand(const HandState& hand) {
+      const int score = Score(hand);
+      if (score > win_point_) {
+        return -1.0;
+      }
+      Values& values = memo_[hand.key];
+      if (values.has_stand) {
+        return values.stand;
+      }
+      Composition dealer_shoe = base_;
+      for (int rank = 0; rank < kNumRanks; ++rank) {
+        dealer_shoe[rank] -= hand.counts[rank];
+      }
+      const auto& dealer = odds_.Compute(dealer_shoe, upcard_);
+      const bool blackjack = hand.cards == 2 && score == win_point_;
+      // No peek: a dealer blackjack beats everything but a player blackjack.
+      double ev = dealer.bust - (blackjack ? 0.0 : dealer.blackjack);
+      for (int total = 0; total <= jaco_dealer_odds::kMaxWinPoint; ++total) {
+        if (total < score) {
+          ev += dealer.total[total];
+        } else if (total > score) {
+          ev -= dealer.total[total];
+        }
+      }
+      values.stand = ev;
+      values.has_stand = true;
+      return ev;
+    }
+
+    /**
+     * @brief EV of taking one card and then playing on optimally (stand or hit).
+     */
+    double Hit(const HandState& hand) {
+      {
+        const Values& values = memo_[hand.key];
+        if (values.has_hit) {
+          return values.hit;
+        }
+      }
+      const int remaining = Remaining(hand);
+      if (remaining <= 0) {
+        return Stand(hand);
+      }
+      double ev = 0.0;
+      for (int rank = 0; rank < kNumRanks; ++rank) {
+        const int left = base_[rank] - hand.counts[rank];
+        if (left <= 0) {
+          continue;
+        }
+        const double p = static_cast<double>(left) / remaining;
+        const HandState next = hand.With(rank);
+        if (Score(next) > win_point_) {
+          ev -= p;
+        } else {
+          ev += p * std::max(Stand(next), Hit(next));
+        }
+      }
+      Values& values = memo_[hand.key];
+      values.hit = ev;
+      values.has_hit = true;
+      return ev;
+    }
+
+    /**
+     * @brief EV of doubling the bet and standing after exactly one card.
+     */
+    double Double(const HandState& hand) {
+      const int remaining = Remaining(hand);
+      if (remaining <= 0) {
+        return 2.0 * Stand(hand);
+      }
+      double ev = 0.0;
+      for (int rank = 0; rank < kNumRanks; ++rank) {
+        const int left = base_[rank] - hand.counts[rank];
+        if (left > 0) {
+          ev += static_cast<double>(left) / remaining * Stand(hand.With(rank));
+        }
+      }
+      return 2.0 * ev;
+    }
+
+    /**
+     * @brief Best of stand, hit and double.
+     */
+    double Best(const HandState& hand) {
+      return std::max({Stand(hand), Hit(hand), Double(hand)});
+    }
+
+    const Composition& Base() const { return base_; }
+
+  private:
+    struct Values {
+      double stand = 0.0;
+      double hit = 0.0;
+      bool has_stand = false;
+      bool has_hit = false;
+    };
+
+    int win_point_;
+    int upcard_;
+    Composition base_;
+    jaco_dealer_odds odds_;
+    std::unordered_map<std::uint64_t, Values> memo_;
+  };
+
+  /**
+   * @brief EV of splitting a pair of @p rank, both hands played without resplits.
+   *
+   * @param base Shoe without the upcard.
+   */
+  double SplitValue(int win_point, int dealer_stop, const Composition& base,
+                    int upcard, int rank) {
+    // Each hand sees the other half of the pair as removed from the shoe.
+    Composition split_base = base;
+    --split_base[rank];
+    UpcardAnalysis split(win_point, dealer_stop, split_base, upcard);
+    const HandState start = HandState{}.With(rank);
+    const int remaining = split.Remaining(start);
+    if (remaining <= 0) {
+      return 2.0 * split.Stand(start);
+    }
+    double ev = 0.0;
+    for (int next = 0; next < kNumRanks; ++next) {
+      const int left = split_base[next] - start.counts[next];
+      if (left > 0) {
+        ev += static_cast<double>(left) / remaining * split.Best(start.With(next));
+      }
+    }
+    return 2.0 * ev;
+  }
+
+  /**
+   * @brief Chart row of a hand that is not treated as a pair.
+   */
+  int RowIndex(bool soft, int total) {
+    return (soft ? 1 : 0) * jaco_strategy_chart::kTotals + total;
+  }
+
+}  // namespace
+
+ITable::Action jaco_strategy_solver::ActionValues::Best() const {
+  ITable::Action best = ITable::Action::Stand;
+  double best_ev = stand;
+  if (hit > best_ev) {
+    best = ITable::Action::Hit;
+    best_ev = hit;
+  }
+  if (double_down > best_ev) {
+    best = ITable::Action::Double;
+    best_ev = double_down;
+  }
+  if (can_split && split > best_ev) {
+    best = ITable::Action::Split;
+  }
+  return best;
+}
+
+jaco_strategy_solver::jaco_strategy_solver(int win_point, int dealer_stop,
+                                           const Composition& shoe)
+    : win_point_(win_point), dealer_stop_(dealer_stop), shoe_(shoe) {}
+
+jaco_strategy_solver::ActionValues jaco_strategy_solver::Evaluate(
+    const Composition& hand, int upcard_rank) const {
+  Composition base = shoe_;
+  --base[upcard_rank];
+  UpcardAnalysis analysis(win_point_, dealer_stop_, base, upcard_rank);
+
+  HandState state;
+  int pair_rank = -1;
+  for (int rank = 0; rank < kNumRanks; ++rank) {
+    for (int i = 0; i < hand[rank]; ++i) {
+      state = state.With(rank);
+    }
+    if (hand[rank] == 2) {
+      pair_rank = rank;
+    }
+  }
+
+  ActionValues values;
+  values.stand = analysis.Stand(state);
+  values.hit = analysis.Hit(state);
+  values.double_down = analysis.Double(state);
+  values.can_split = state.cards == 2 && pair_rank >= 0;
+  if (values.can_split) {
+    values.split = SplitValue(win_point_, dealer_stop_, base, upcard_rank, pair_rank);
+  }
+  return values;
+}
+
+/**
+ * @brief Solves every row for one upcard.
+ *
+ * Hands of 2..@ref kMaxRepresentativeCards cards are enumerated with their
+ * deal probabilities; each hard or soft row takes the weighted EVs of the
+ * smallest hands that reach it, pair rows use the pair itself.
+ */
+void jaco_strategy_solver::SolveUpcard(int upcard_rank,
+                                       jaco_strategy_chart& chart) const {
+  using HandClass = jaco_strategy_chart::HandClass;
+  Composition base = shoe_;
+  if (base[upcard_rank] <= 0) {
+    return;
+  }
+  --base[upcard_rank];
+  UpcardAnalysis analysis(win_point_, dealer_stop_, base, upcard_rank);
+
+  struct Weighted {
+    HandState hand;
+    double weight = 0.0;
+  };
+  struct RowValues {
+    double stand = 0.0, hit = 0.0, double_down = 0.0, weight = 0.0;
+  };
+  std::vector<RowValues> rows(2 * jaco_strategy_chart::kTotals);
+  std::vector<bool> row_done(rows.size(), false);
+
+  // Hands of the current size with their deal probability (all orderings summed).
+  std::unordered_map<std::uint64_t, Weighted> level;
+  level[0] = Weighted{HandState{}, 1.0};
+  for (int cards = 1; cards <= kMaxRepresentativeCards; ++cards) {
+    std::unordered_map<std::uint64_t, Weighted> next_level;
+    for (const auto& entry : level) {
+      const HandState& hand = entry.second.hand;
+      const int remaining = analysis.Remaining(hand);
+      for (int rank = 0; rank < kNumRanks && remaining > 0; ++rank) {
+        const int left = base[rank] - hand.counts[rank];
+        if (left <= 0) {
+          continue;
+        }
+        const HandState next = hand.With(rank);
+        if (analysis.Score(next) > win_point_) {
+          continue;
+        }
+        Weighted& slot = next_level[next.key];
+        slot.hand = next;
+        slot.weight += entry.second.weight * left / remaining;
+      }
+    }
+    level.swap(next_level);
+    if (cards < 2) {
+      continue;
+    }
+
+    std::vector<bool> reached(rows.size(), false);
+    for (const auto& entry : level) {
+      const HandState& hand = entry.second.hand;
+      const int score = analysis.Score(hand);
+      const int row = RowIndex(score != hand.hard_total, score);
+      if (row_done[row]) {
+        continue;
+      }
+      reached[row] = true;
+      const double weight = entry.second.weight;
+      rows[row].stand += weight * analysis.Stand(hand);
+      rows[row].hit += weight * analysis.Hit(hand);
+      rows[row].double_down += weight * analysis.Double(hand);
+      rows[row].weight += weight;
+    }
+    for (size_t row = 0; row < rows.size(); ++row) {
+      row_done[row] = row_done[row] || reached[row];
+    }
+  }
+
+  for (int soft = 0; soft <= 1; ++soft) {
+    const HandClass hand_class = soft ? HandClass::Soft : HandClass::Hard;
+    ITable::Action previous = ITable::Action::Hit;
+    for (int total = 0; total < jaco_strategy_chart::kTotals; ++total) {
+      const RowValues& row = rows[RowIndex(soft != 0, total)];
+      ITable::Action action = previous;
+      if (total > win_point_) {
+        action = ITable::Action::Stand;
+      } else if (row.weight > 0.0) {
+        ActionValues values;
+        values.stand = row.stand / row.weight;
+        values.hit = row.hit / row.weight;
+        values.double_down = row.double_down / row.weight;
+        action = values.Best();
+      }
+      // Rows no small hand reaches repeat the row below.
+      chart.Set(hand_class, total, upcard_rank, action);
+      previous = action;
+    }
+  }
+
+  for (int rank = 0; rank < kNumRanks; ++rank) {
+    if (base[rank] < 2) {
+      continue;
+    }
+    const HandState pair = HandState{}.With(rank).With(rank);
+    ActionValues values;
+    values.stand = analysis.Stand(pair);
+    values.hit = analysis.Hit(pair);
+    values.double_down = analysis.Double(pair);
+    values.can_split = true;
+    values.split = SplitValue(win_point_, dealer_stop_, base, upcard_rank, rank);
+    chart.Set(HandClass::Pair, rank, upcard_rank, values.Best());
+  }
+}
+
+/**
+ * @brief Spreads the upcards over worker threads; each owns its memo tables.
+ */
+jaco_strategy_chart jaco_strategy_solver::Solve(int threads) const {
+  jaco_strategy_chart chart;
+  const int count = (threads <= 0 || threads > kNumRanks) ? kNumRanks : threads;
+  std::atomic<int> next_upcard(0);
+  auto worker = [&] {
+    // Upcards write disjoint columns of the chart.
+    for (int upcard = next_upcard++; upcard < kNumRanks; upcard = next_upcard++) {
+      SolveUpcard(upcard, chart);
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    workers.emplace_back(worker);
+  }
+  for (auto& thread : workers) {
+    thread.join();
+  }
+  return chart;
+}
+
+std::string jaco_strategy_solver::Format(const jaco_strategy_chart& chart,
+                                         int win_point) {
+  using HandClass = jaco_strategy_chart::HandClass;
+  static const char kActions[] = {'S', 'H', 'D', 'P'};
+  static const char* const kRanks[] = {"A", "2", "3", "4", "5",
+                                       "6", "7", "8", "9", "T"};
+  // Conventional column order: 2..9, T, A.
+  static const int kColumns[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 0};
+
+  std::string text;
+  char line[128];
+  auto header = [&](const char* title) {
+    text += title;
+    text += "   ";
+    for (const int upcard : kColumns) {
+      text += ' ';
+      text += kRanks[upcard];
+    }
+    text += '\n';
+  };
+  auto row = [&](const char* label, HandClass hand_class, int total) {
+    std::snprintf(line, sizeof(line), "%-8s", label);
+    text += line;
+    for (const int upcard : kColumns) {
+      text += ' ';
+      text += kActions[static_cast<int>(chart.Lookup(hand_class, total, upcard))];
+    }
+    text += '\n';
+  };
+
+  header("Hard ");
+  for (int total = 4; total <= win_point; ++total) {
+    row(std::to_string(total).c_str(), HandClass::Hard, total);
+  }
+  header("Soft ");
+  for (int total = 12; total <= win_point; ++total) {
+    row(std::to_string(total).c_str(), HandClass::Soft, total);
+  }
+  header("Pair ");
+  for (int rank = 0; rank < kNumRanks; ++rank) {
+    const std::string label = std::string(kRanks[rank]) + "," + kRanks[rank];
+    row(label.c_str(), HandClass::Pair, rank);
+  }
+  return text;
+}
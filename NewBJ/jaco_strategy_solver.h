@@ -0,0 +1,111 @@
+#pragma once
+#ifndef JACO_STRATEGY_SOLVER_H
+#define JACO_STRATEGY_SOLVER_H
+#include "NewBJ/jaco_dealer_odds.h"
+#include "NewBJ/jaco_strategy_chart.h"
+#include <string>
+
+/**
+ * @class jaco_strategy_solver
+ * @brief Combinatorial basic-strategy solver for an arbitrary rule set.
+ *
+ * Computes the expected value (in initial bets) of standing, hitting,
+ * doubling and splitting for a player hand against a dealer upcard, drawing
+ * without replacement from a finite shoe. Standing is scored against the
+ * exact dealer distribution of @ref jaco_dealer_odds for the shoe minus the
+ * player's cards; hitting recurses over the next card and is memoized on the
+ * hand's multiset of cards.
+ *
+ * The engine's payouts are modelled as the table settles them: every win
+ * pays 1:1, a player blackjack only ties a dealer blackjack, and the dealer
+ * does not peek, so doubled and split bets are lost in full to a dealer
+ * blackjack. Split hands are played out once without resplitting, which is
+ * the usual approximation.
+ *
+ * @ref Solve builds a total-dependent chart: each row is decided from the
+ * probability-weighted EVs of the hands with the fewest cards that reach it.
+ */
+class jaco_strategy_solver {
+public:
+    using Composition = jaco_dealer_odds::Composition;
+
+    /**
+     * @struct ActionValues
+     * @brief Expected value of each action, in units of the initial bet.
+     */
+    struct ActionValues {
+        double stand = 0.0;
+        double hit = 0.0;
+        double double_down = 0.0;
+        double split = 0.0;   ///< Only meaningful when @ref can_split
+        bool can_split = false;
+
+        /**
+         * @brief Action with the highest expected value.
+         */
+        ITable::Action Best() const;
+    };
+
+    /**
+     * @brief Creates a solver for an explicit rule set and full shoe.
+     * @param win_point Score needed to win.
+     * @param dealer_stop Score at which the dealer stops drawing.
+     * @param shoe Cards in the shoe before the deal.
+     */
+    jaco_strategy_solver(int win_point, int dealer_stop, const Composition& shoe);
+
+    /**
+     * @brief Creates a solver for a fresh shoe under a rule set.
+     * @param rules @ref jaco_rules or a static rule set.
+     */
+    template <class Rules>
+    explicit jaco_strategy_solver(const Rules& rules)
+        : jaco_strategy_solver(rules.GetWinPoint(), rules.DealerStop(),
+                               jaco_dealer_odds::FullShoe(rules.NumberOfDecks())) {}
+
+    /**
+     * @brief Evaluates every action for one hand.
+     *
+     * @param hand Cards in the player's hand.
+     * @param upcard_rank Point rank of the dealer's face-up card.
+     * @return ActionValues EVs of stand, hit, double and (for pairs) split.
+     */
+    ActionValues Evaluate(const Composition& hand, int upcard_rank) const;
+
+    /**
+     * @brief Builds the complete chart, one worker thread per upcard.
+     *
+     * @param threads Maximum worker threads (0 = one per upcard).
+     * @return jaco_strategy_chart Best action for every row and upcard.
+     */
+    jaco_strategy_chart Solve(int threads = 0) const;
+
+    /**
+     * @brief Renders a chart as text, one block per hand class.
+     * @param chart Chart to print.
+     * @param win_point Highest total printed.
+     */
+    static std::string Format(const jaco_strategy_chart& chart, int win_point);
+
+    /**
+     * @brief Gets the win point the solver was built for.
+     */
+    int WinPoint() const { return win_point_; }
+
+private:
+    /**
+     * @brief Fills the column of one upcard.
+     */
+    void SolveUpcard(int upcard_rank, jaco_strategy_chart& chart) const;
+
+    /** @brief Score needed to win. */
+    int win_point_;
+
+    /** @brief Score at which the dealer stops drawing. */
+    int dealer_stop_;
+
+    /** @brief Cards in the shoe before the deal. */
+    Composition shoe_;
+};
+
+#endif // JACO_STRATEGY_SOLVER_H
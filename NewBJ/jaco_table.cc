@@ -1,100 +1,77 @@
 #include "NewBJ/jaco_table.h"
+#include "NewBJ/jaco_log.h"
+#include "NewBJ/jaco_profile.h"
+#include "NewBJ/jaco_alloc.h"
+#include <algorithm>
 
 /**
  * @brief Builds the table, initializes dealer money and reserves player slots.
  * @param rules Rule set controlling limits and thresholds.
  */
-jaco_table::jaco_table(const jaco_rules& rules, std::vector<jaco_player>& players)
+jaco_table::jaco_table(const jaco_rules& rules, std::vector<jaco_player>& players,
+                       std::uint64_t seed, std::uint64_t table_id)
     : rules_(rules),
-      deck_(),
+      deck_(rules.NumberOfDecks(), rules.Penetration()),
       players_(players),
       dealer_hand_(),
+      dealer_hard_total_(0),
+      dealer_aces_(0),
       dealer_money_(rules.InitialDealerMoney()),
       initial_bets_(players.size(), 0),
       safe_bets_(players.size(), 0),
-      hands_bets_(players.size(), std::vector<int>(1, 0)) {
+      hands_bets_(players.size(),
+                  jaco_fixed_vector<int, jaco_player::kMaxHands>(1, 0)) {
   players_.reserve(ITable::kMaxPlayers);
+  deck_.SetSeed(seed, table_id);
+  deck_.shuffleCards();
 }
 
 /**
- * @brief Converts a card from internal deck format to interface format.
- * @param card Card in @ref Cards representation.
- * @return Mapped card compatible with ITable consumers.
+ * @brief Seeds the shoe and reshuffles it from the ordered state.
  */
-ITable::Card jaco_table::ConvertCard(const Cards::Card& card) const {
-  ITable::Card converted{};
-  converted.value_ = static_cast<ITable::Value>(static_cast<int>(card.fig));
-  switch (card.suit) {
-    case Cards::Suit::Clubs:
-      converted.suit_ = ITable::Suit::CLUBS;
-      break;
-    case Cards::Suit::Diamons:
-      converted.suit_ = ITable::Suit::DIAMONDS;
-      break;
-    case Cards::Suit::Hearts:
-      converted.suit_ = ITable::Suit::HEARTS;
-      break;
-    case Cards::Suit::Spades:
-      converted.suit_ = ITable::Suit::SPADES;
-      break;
-  }
-  return converted;
+void jaco_table::SetSeed(std::uint64_t seed, std::uint64_t table_id) {
+  deck_.SetSeed(seed, table_id);
+  deck_.shuffleCards();
 }
 
 /**
- * @brief Computes dealer hand score, adjusting aces to avoid bust if possible.
- * @return Total dealer score.
+ * @brief Re-keys the shoe only when it belongs to another recording.
  */
-int jaco_table::DealerHandScore() const {
-  int score = 0;
-  int aces = 0;
-  for (const auto& card : dealer_hand_) {
-    // Map interface values to blackjack totals.
-    switch (card.value_) {
-      case ITable::Value::ACE:
-        score += 11;
-        ++aces;
-        break;
-      case ITable::Value::TWO:
-        score += 2;
-        break;
-      case ITable::Value::THREE:
-        score += 3;
-        break;
-      case ITable::Value::FOUR:
-        score += 4;
-        break;
-      case ITable::Value::FIVE:
-        score += 5;
-        break;
-      case ITable::Value::SIX:
-        score += 6;
-        break;
-      case ITable::Value::SEVEN:
-        score += 7;
-        break;
-      case ITable::Value::EIGHT:
-        score += 8;
-        break;
-      case ITable::Value::NINE:
-        score += 9;
-        break;
-      case ITable::Value::TEN:
-      case ITable::Value::JACK:
-      case ITable::Value::QUEEN:
-      case ITable::Value::KING:
-        score += 10;
-        break;
-      default:
-        break;
-    }
-  }
-  // Convert aces from 11 to 1 while busting.
-  while (score > rules_.GetWinPoint() && aces > 0) {
-    score -= 10;
-    --aces;
+void jaco_table::RestoreShoe(std::uint64_t seed, std::uint64_t table_id,
+                             const Cards::State& state) {
+  if (deck_.GetSeed() != seed || deck_.TableId() != table_id) {
+    deck_.SetSeed(seed, table_id);
   }
-  return score;
+  deck_.Restore(state);
+}
+
+/**
+ * @brief Copies a shared shoe so the next round deals the same cards.
+ */
+void jaco_table::LoadShoe(const Cards& shoe) {
+  deck_.Arrange(shoe);
+}
+
+/**
+ * @brief Draws a card for the dealer and updates the running totals.
+ */
+void jaco_table::DealDealerCard() {
+  const Card card = deck_.giveCard();
+  // Jack, Queen and King are worth 10, aces are counted as 1 here.
+  dealer_hard_total_ += Cards::Points(card);
+  if (card.value_ == Value::ACE) {
+    ++dealer_aces_;
+  }
+  dealer_hand_.push_back(card);
+}
+
+/**
+ * @brief Empties the dealer hand and its running totals.
+ */
+void jaco_table::ClearDealerHand() {
+  dealer_hand_.clear();
+  dealer_hard_total_ = 0;
+  dealer_aces_ = 0;
 }
 
 /**
@@ -102,6 +79,7 @@ int jaco_table::DealerHandScore() const {
  * @param player_index Player to ensure.
  */
 bool jaco_table::EnsurePlayer(int player_index) {
+  JACO_ALLOC_SCOPE(Hands);
   if (player_index < 0 || player_index >= static_cast<int>(players_.size())) {
     return false;
   }
@@ -114,7 +92,8 @@ bool jaco_table::EnsurePlayer(int player_index) {
     safe_bets_.resize(players_.size(), 0);
   }
   if (static_cast<int>(hands_bets_.size()) < static_cast<int>(players_.size())) {
-    hands_bets_.resize(players_.size(), std::vector<int>(1, 0));
+    hands_bets_.resize(players_.size(),
+                       jaco_fixed_vector<int, jaco_player::kMaxHands>(1, 0));
   }
 
   return true;
@@ -129,7 +108,7 @@ void jaco_table::EnsureHandBets(int player_index) {
     return;
   }
   auto& bets = hands_bets_[player_index];
-  const auto hand_count = players_[player_index].PlayerHand.size();
+  const int hand_count = players_[player_index].PlayerHand.size();
   if (bets.size() < hand_count) {
     // Propagate existing bet to new split hand or initialize to zero.
     bets.resize(hand_count, bets.empty() ? 0 : bets.front());
@@ -137,12 +116,28 @@ void jaco_table::EnsureHandBets(int player_index) {
 }
 
 /**
- * @brief Returns specified player hand mapped to interface cards.
+ * @brief Returns a copy of the specified player hand.
+ *
+ * Kept for compatibility; built on top of @ref GetHandView.
+ *
  * @param player_index Player index.
  * @param hand_index Hand index.
  * @return Hand vector ready for observers.
  */
 ITable::Hand jaco_table::GetHand(int player_index, int hand_index) const {
+  JACO_ALLOC_SCOPE(Interface);
+  const HandView view = GetHandView(player_index, hand_index);
+  return Hand(view.begin(), view.end());
+}
+
+/**
+ * @brief Returns a view over the player's own storage of the hand.
+ * @param player_index Player index.
+ * @param hand_index Hand index.
+ * @return View over the cards, empty on invalid indices.
+ */
+ITable::HandView jaco_table::GetHandView(int player_index,
+                                         int hand_index) const {
   if (player_index < 0 || player_index >= static_cast<int>(players_.size())) {
     return {};
   }
@@ -151,11 +146,41 @@ ITable::Hand jaco_table::GetHand(int player_index, int hand_index) const {
       hand_index >= static_cast<int>(player.PlayerHand.size())) {
     return {};
   }
-  ITable::Hand hand;
-  for (const auto& card : player.PlayerHand[hand_index].cards) {
-    hand.push_back(ConvertCard(card));
+  const auto& cards = player.PlayerHand[hand_index].cards;
+  return HandView{cards.data(), static_cast<int>(cards.size())};
+}
+
+/**
+ * @brief Builds a hand summary from the player's running totals.
+ * @param player_index Player index.
+ * @param hand_index Hand index.
+ * @return Summary of the hand, all zero on invalid indices.
+ */
+ITable::HandSummary jaco_table::GetHandSummary(int player_index,
+                                               int hand_index) const {
+  HandSummary summary;
+  if (player_index < 0 || player_index >= static_cast<int>(players_.size())) {
+    return summary;
   }
-  return hand;
+  const auto& player = players_[player_index];
+  if (hand_index < 0 ||
+      hand_index >= static_cast<int>(player.PlayerHand.size())) {
+    return summary;
+  }
+  summary.score = player.HandScore(hand_index);
+  summary.cards = static_cast<int>(player.PlayerHand[hand_index].cards.size());
+  summary.soft = player.IsSoft(hand_index);
+  summary.pair = player.IsPair(hand_index);
+  summary.blackjack = player.isBlackjack(hand_index);
+  summary.bust = player.isBust(hand_index);
+  return summary;
+}
+
+/**
+ * @brief Returns a view over the dealer's hand.
+ */
+ITable::HandView jaco_table::GetDealerHandView() const {
+  return HandView{dealer_hand_.data(), static_cast<int>(dealer_hand_.size())};
 }
 
 /**
@@ -306,37 +331,54 @@ ITable::Result jaco_table::ApplyPlayerAction(int player_index, int hand_index,
   if (!EnsurePlayer(player_index)) {
     return Result::Illegal;
   }
-  auto& player = players_[player_index];
+  const auto& player = players_[player_index];
   if (hand_index < 0 ||
       hand_index >= static_cast<int>(player.PlayerHand.size())) {
     return Result::Illegal;
   }
 
   EnsureHandBets(player_index);
+  return ApplyAction(player_index, hand_index, action);
+}
+
+/**
+ * @brief Executes an action on a hand known to exist.
+ * @param player_index Player performing action.
+ * @param hand_index Hand to affect.
+ * @param action Action to apply.
+ * @return Ok if applied, Illegal if constraints violated.
+ */
+ITable::Result jaco_table::ApplyAction(int player_index, int hand_index,
+                                       Action action) {
+  auto& player = players_[player_index];
+  auto& bets = hands_bets_[player_index];
   switch (action) {
     case Action::Stand:
       return Result::Ok;
     case Action::Hit:
-      DealCard(player_index, hand_index);
+      if (player.IsHandFull(hand_index) || player.PlayerHand[hand_index].doubled) {
+        return Result::Illegal;
+      }
+      player.AddCardUnchecked(deck_.giveCard(), hand_index);
       return Result::Ok;
     case Action::Double: {
-      const int current_bet = hands_bets_[player_index][hand_index];
-      if (current_bet <= 0 || player.player_money < current_bet) {
+      const int current_bet = bets[hand_index];
+      if (current_bet <= 0 || player.player_money < current_bet ||
+          player.IsHandFull(hand_index) || player.PlayerHand[hand_index].doubled) {
         return Result::Illegal;
       }
       // Double the stake and take exactly one extra card.
       player.player_money -= current_bet;
-      hands_bets_[player_index][hand_index] += current_bet;
-      DealCard(player_index, hand_index);
+      bets[hand_index] += current_bet;
+      player.AddCardUnchecked(deck_.giveCard(), hand_index);
+      player.PlayerHand[hand_index].doubled = true;
       return Result::Ok;
     }
     case Action::Split: {
-      auto& hand = player.PlayerHand[hand_index];
-      if (hand.cards.size() != 2 ||
-          hand.cards[0].fig != hand.cards[1].fig) {
+      if (!player.IsPair(hand_index) || player.PlayerHand.full()) {
         return Result::Illegal;
       }
-      const int current_bet = hands_bets_[player_index][hand_index];
+      const int current_bet = bets[hand_index];
       if (current_bet <= 0 || player.player_money < current_bet) {
         return Result::Illegal;
       }
@@ -345,16 +387,11 @@ ITable::Result jaco_table::ApplyPlayerAction(int player_index, int hand_index,
       player.player_money -= current_bet;
 
       // Move one card to the new hand and keep the other.
-      jaco_player::Hand new_hand;
-      new_hand.hand_index = static_cast<int>(player.PlayerHand.size());
-      new_hand.cards.push_back(hand.cards.back());
-      hand.cards.pop_back();
-
-      player.PlayerHand.push_back(new_hand);
-      hands_bets_[player_index].push_back(current_bet);
+      const int new_hand_index = player.SplitHand(hand_index);
+      bets.push_back(current_bet);
 
-      DealCard(player_index, hand_index);
-      DealCard(player_index, new_hand.hand_index);
+      player.AddCardUnchecked(deck_.giveCard(), hand_index);
+      player.AddCardUnchecked(deck_.giveCard(), new_hand_index);
       return Result::Ok;
     }
   }
@@ -362,16 +399,16 @@ ITable::Result jaco_table::ApplyPlayerAction(int player_index, int hand_index,
 }
 
 /**
- * @brief Prepares a new round resetting deck, dealer card and player state.
+ * @brief Prepares a new round: reshuffles the shoe only at the cut card,
+ * deals the dealer card and resets player state.
  */
 void jaco_table::StartRound() {
   /// Ensure bookkeeping vectors match current player count without minting new players.
   EnsurePlayer(static_cast<int>(players_.size()) - 1);
 
-  deck_ = Cards();
-  deck_.shuffleCards();
-  dealer_hand_.clear();
-  dealer_hand_.push_back(ConvertCard(deck_.giveCard()));
+  deck_.BeginRound();
+  ClearDealerHand();
+  DealDealerCard();
 
   for (size_t i = 0; i < players_.size(); ++i) {
     players_[i].InitHand(deck_);
@@ -383,42 +420,86 @@ void jaco_table::StartRound() {
 }
 
 /**
- * @brief Resolves dealer play, calculates payouts and resets table state.
+ * @brief Resolves the round and converts the flat results to RoundEndInfo.
  * @return RoundEndInfo summarizing results and money changes.
  */
 ITable::RoundEndInfo jaco_table::FinishRound() {
+  JACO_ALLOC_SCOPE(Results);
+  RoundResults settled;
+  SettleRound(settled);
+
+  ITable::RoundEndInfo result;
+  result.dealer_hand = settled.dealer_hand;
+  result.winners.resize(settled.hand_counts.size());
+  for (size_t i = 0; i < settled.hand_counts.size(); ++i) {
+    for (int h = 0; h < settled.hand_counts[i]; ++h) {
+      result.winners[i].push_back(settled.Winner(static_cast<int>(i), h));
+    }
+  }
+  result.player_money_delta = settled.player_money_delta;
+  result.croupier_money_delta = settled.croupier_money_delta;
+  return result;
+}
+
+/**
+ * @brief Settles the round with the table's runtime rules.
+ * @param result Reused buffer receiving results and money changes.
+ */
+void jaco_table::SettleRound(RoundResults& result) {
+  SettleRound(result, rules_);
+}
+
+/**
+ * @brief Resolves dealer play, calculates payouts and resets table state.
+ * @param result Reused buffer receiving results and money changes.
+ * @param rules Rule set providing win point and dealer stop.
+ */
+template <class Rules>
+void jaco_table::SettleRound(RoundResults& result, const Rules& rules) {
   // Dealer plays their hand according to the rules
-  while (DealerHandScore() < rules_.DealerStop()) {
-    dealer_hand_.push_back(ConvertCard(deck_.giveCard()));
+  const int dealer_stop = rules.DealerStop();
+  while (DealerHandScore(rules) < dealer_stop && !dealer_hand_.full()) {
+    DealDealerCard();
   }
+  JACO_PROFILE_MARK(DealerDraw);
+  JACO_ALLOC_SCOPE(Results);
 
-  ITable::RoundEndInfo result;
-  result.dealer_hand = dealer_hand_;
-  result.winners.resize(players_.size());
+  // Size the flat buffers; assign() keeps their capacity between rounds.
+  int hand_stride = 1;
+  for (size_t i = 0; i < players_.size(); ++i) {
+    hand_stride = std::max(hand_stride,
+                           static_cast<int>(players_[i].PlayerHand.size()));
+  }
+  result.dealer_hand.assign(dealer_hand_.begin(), dealer_hand_.end());
+  result.hand_stride = hand_stride;
+  result.winners.assign(players_.size() * hand_stride,
+                        ITable::RoundEndInfo::BetResult::Tie);
+  result.hand_counts.assign(players_.size(), 0);
   result.player_money_delta.assign(players_.size(), 0);
+  result.hand_bets.assign(players_.size() * hand_stride, 0);
+  result.insurance_bets.assign(players_.size(), 0);
   result.croupier_money_delta = 0;
 
-  const int dealer_score = DealerHandScore();
+  const int dealer_score = DealerHandScore(rules);
   const bool dealer_blackjack =
-      dealer_hand_.size() == 2 && dealer_score == rules_.GetWinPoint();
-  const bool dealer_bust = dealer_score > rules_.GetWinPoint();
+      dealer_hand_.size() == 2 && dealer_score == rules.GetWinPoint();
+  const bool dealer_bust = dealer_score > rules.GetWinPoint();
 
   for (size_t i = 0; i < players_.size(); ++i) {
     EnsureHandBets(static_cast<int>(i));
     auto& player = players_[i];
     auto& bets = hands_bets_[i];
-    result.winners[i].resize(player.PlayerHand.size(),
-                             ITable::RoundEndInfo::BetResult::Tie);
+    result.hand_counts[i] = static_cast<int>(player.PlayerHand.size());
 
-    for (size_t h = 0; h < player.PlayerHand.size(); ++h) {
+    for (int h = 0; h < player.PlayerHand.size(); ++h) {
       const int bet = (h < bets.size()) ? bets[h] : 0;
       int payout = 0;
       auto hand_result = ITable::RoundEndInfo::BetResult::Tie;
 
-      const int player_score = player.HandScore(static_cast<int>(h));
-      const bool player_blackjack = player.isBlackjack(static_cast<int>(h));
+      const int player_score = player.HandScore(h, rules);
+      const bool player_blackjack = player.isBlackjack(h, rules);
 
-      if (player.isBust(static_cast<int>(h))) {
+      if (player.isBust(h, rules)) {
         hand_result = ITable::RoundEndInfo::BetResult::Lose;
       } else if (dealer_blackjack) {
         if (player_blackjack) {
@@ -445,12 +526,14 @@ ITable::RoundEndInfo jaco_table::FinishRound() {
       player.player_money += payout;
       result.player_money_delta[i] += payout;
       result.croupier_money_delta += (bet - payout);
-      result.winners[i][h] = hand_result;
+      result.winners[i * hand_stride + h] = hand_result;
+      result.hand_bets[i * hand_stride + h] = bet;
     }
 
     // Resolve safe/insurance bet
     if (safe_bets_[i] > 0) {
       const int bet = safe_bets_[i];
+      result.insurance_bets[i] = bet;
       int payout = 0;
       if (dealer_blackjack) {
         // Insurance pays 2:1 plus returning stake (3x total back).
@@ -471,43 +554,29 @@ ITable::RoundEndInfo jaco_table::FinishRound() {
   ShowDealerHand();
 
   dealer_money_ += result.croupier_money_delta;
-  dealer_hand_.clear();
-
-  return result;
+  ClearDealerHand();
 }
 
+// Settlement compiled for each built-in static rule set.
+template void jaco_table::SettleRound<jaco_classic_rules>(
+    RoundResults&, const jaco_classic_rules&);
+template void jaco_table::SettleRound<jaco_round_rules>(
+    RoundResults&, const jaco_round_rules&);
+template void jaco_table::SettleRound<jaco_extreme_rules>(
+    RoundResults&, const jaco_extreme_rules&);
+
 /**
- * @brief Prints the dealer's hand to standard output.
+ * @brief Writes the dealer's hand to the log (Info level).
  */
 void jaco_table::ShowDealerHand() const {
-  std::cout << " Dealer's Hand: ";
+  if (!jaco_log::Enabled(jaco_log::Level::Info)) {
+    return;
+  }
+  std::ostream& out = jaco_log::Stream();
+  out << " Dealer's Hand: ";
   for (const auto& card : dealer_hand_) {
-    // Print card value
-    switch(card.value_) {
-      case ITable::Value::ACE:    std::cout << "\n  Ace";   break;
-      case ITable::Value::TWO:    std::cout << "\n  Two";   break;
-      case ITable::Value::THREE:  std::cout << "\n  Three"; break;
-      case ITable::Value::FOUR:   std::cout << "\n  Four";  break;
-      case ITable::Value::FIVE:   std::cout << "\n  Five";  break;
-      case ITable::Value::SIX:    std::cout << "\n  Six";   break;
-      case ITable::Value::SEVEN:  std::cout << "\n  Seven"; break;
-      case ITable::Value::EIGHT:  std::cout << "\n  Eight"; break;
-      case ITable::Value::NINE:   std::cout << "\n  Nine";  break;
-      case ITable::Value::TEN:    std::cout << "\n  Ten";   break;
-      case ITable::Value::JACK:   std::cout << "\n  Jack";  break;
-      case ITable::Value::QUEEN:  std::cout << "\n  Queen"; break;
-      case ITable::Value::KING:   std::cout << "\n  King";  break;
-      default:  std::cout << "\n  Unknown";   break;
-    }
-    std::cout << " of ";
-    // Print card suit
-    switch(card.suit_) {
-      case ITable::Suit::HEARTS:    std::cout << "Hearts";   break;
-      case ITable::Suit::CLUBS:     std::cout << "Clubs";    break;
-      case ITable::Suit::SPADES:    std::cout << "Spades";   break;
-      case ITable::Suit::DIAMONDS:  std::cout << "Diamonds"; break;
-      default:  std::cout << "Unknown";   break;
-    }
+    out << "\n  " << Cards::PrintFig(card.value_) << " of "
+        << Cards::PrintSuit(card.suit_);
   }
-  std::cout << std::endl;
+  out << "\n";
 }
@@ -4,7 +4,9 @@
 #include "Interface/itable.h"
 #include "NewBJ/jaco_player.h"
 #include "NewBJ/jaco_rules.h"
+#include "NewBJ/jaco_rules_policy.h"
 #include "NewBJ/cards.h"
+#include "NewBJ/jaco_fixed_vector.h"
 #include <vector>
 
 /**
@@ -15,15 +17,27 @@
  * bets, dealer hand and money, and the flow of each round. It provides the
  * concrete behavior for all methods defined in the ITable interface:
  * dealing cards, starting and finishing rounds, and applying player actions.
+ *
+ * The class is final: code holding a jaco_table (see @ref jaco_game::PlayRound)
+ * gets direct, inlinable calls, while bots and observers keep using the
+ * ITable interface.
  */
-class jaco_table : public ITable {
+class jaco_table final : public ITable {
 public:
     /**
      * @brief Constructs a table using provided rules and initializes dealer money.
+     *
+     * Builds a shoe of @ref jaco_rules::NumberOfDecks decks with the cut card
+     * at @ref jaco_rules::Penetration, keys it with (@p seed, @p table_id)
+     * and shuffles it once.
+     *
      * @param rules Rule set controlling bets, decks and limits.
+     * @param seed Master seed of the run.
+     * @param table_id Identifier of this table within the run.
      */
     explicit jaco_table(const jaco_rules& rules,
-                        std::vector<jaco_player>& players);
+                        std::vector<jaco_player>& players,
+                        std::uint64_t seed = 0, std::uint64_t table_id = 0);
 
     /**
      * @brief Gets a specific hand for a player.
@@ -34,6 +48,31 @@ public:
      */
     Hand GetHand(int player_index, int hand_index) const override;
 
+    /**
+     * @brief Gets a non-owning view of a specific hand for a player.
+     *
+     * @param player_index Index of the player
+     * @param hand_index Index of the hand
+     * @return HandView View over the player's own card storage
+     */
+    HandView GetHandView(int player_index, int hand_index) const override;
+
+    /**
+     * @brief Gets the precomputed score, soft and pair state of a hand.
+     *
+     * @param player_index Index of the player
+     * @param hand_index Index of the hand
+     * @return HandSummary Summary read from the hand's running totals
+     */
+    HandSummary GetHandSummary(int player_index, int hand_index) const override;
+
+    /**
+     * @brief Gets a non-owning view of the dealer's current hand.
+     *
+     * @return HandView View over the dealer's cards
+     */
+    HandView GetDealerHandView() const override;
+
     /**
      * @brief Gets the current number of hands for a player.
      *
@@ -118,11 +157,27 @@ public:
      */
     Result ApplyPlayerAction(int player_index,int hand_index,Action action) override;
 
+    /**
+     * @brief Applies a player action without validating the indices.
+     *
+     * Static-dispatch counterpart of @ref ApplyPlayerAction. The caller
+     * guarantees that the player and hand exist; per-hand bets are already in
+     * sync because StartRound, PlayInitialBet and splits maintain them, so the
+     * EnsurePlayer/EnsureHandBets passes are skipped. Game rules (full hands,
+     * funds, pairs) are still enforced.
+     *
+     * @param player_index Index of an existing player
+     * @param hand_index Index of an existing hand of that player
+     * @param action The action to perform (Stand, Hit, Double, Split)
+     * @return Result Ok if the action was valid, Illegal otherwise
+     */
+    Result ApplyAction(int player_index,int hand_index,Action action);
+
     /**
      * @brief Prepares the start of a round.
      *
      * This method performs the following operations:
-     * - Shuffles the deck
+     * - Reshuffles the shoe if the cut card has been reached
      * - Deals one card to the dealer
      */
     void StartRound() override;
@@ -141,24 +196,107 @@ public:
     RoundEndInfo FinishRound() override;
 
     /**
-     * @brief Prints the dealer's hand to standard output.
+     * @brief Calculates the end of a round into a caller-owned buffer.
+     *
+     * Same as @ref FinishRound without allocating once @p results has grown
+     * to the table's size.
+     *
+     * @param results Buffer overwritten with the round results
+     */
+    void SettleRound(RoundResults& results) override;
+
+    /**
+     * @brief Settles the round under an explicit rule set.
+     *
+     * The runtime overload passes the table's @ref jaco_rules; passing a
+     * @ref jaco_static_rules set compiles the dealer loop and the payout
+     * comparisons against constant thresholds. Instantiated in jaco_table.cc
+     * for jaco_rules and the built-in static rule sets.
+     *
+     * @param results Buffer overwritten with the round results
+     * @param rules Static rule set or @ref jaco_rules
+     */
+    template <class Rules>
+    void SettleRound(RoundResults& results, const Rules& rules);
+
+    /**
+     * @brief Writes the dealer's hand to the game log (see @ref jaco_log).
      */
     void ShowDealerHand() const;
 
-private:
+    /**
+     * @brief Makes the shoe reproducible and reshuffles it.
+     *
+     * Every later shuffle is keyed by (seed, table id, round number).
+     *
+     * @param seed Master seed of the run.
+     * @param table_id Identifier of this table within the run.
+     */
+    void SetSeed(std::uint64_t seed, std::uint64_t table_id);
 
     /**
-     * @brief Maps an internal deck card to interface card type.
-     * @param card Card from @ref Cards.
-     * @return ITable::Card with matching value and suit.
+     * @brief Rebuilds the shoe of another table at a recorded round boundary.
+     *
+     * Switches the shoe to (@p seed, @p table_id) without reshuffling and
+     * restores @p state, so records of one shoe replayed in order only
+     * reshuffle when the recorded shoe did. The next @ref StartRound deals
+     * the recorded round.
+     *
+     * @param seed Master seed of the recorded shoe.
+     * @param table_id Table id of the recorded shoe.
+     * @param state Shoe state at the start of the round (@ref Cards::RoundState).
      */
-    Card ConvertCard(const Cards::Card& card) const;
-    
+    void RestoreShoe(std::uint64_t seed, std::uint64_t table_id, const Cards::State& state);
+
+    /**
+     * @brief Makes the next round deal from a copy of another shoe.
+     *
+     * @p shoe must have just started a round, so @ref StartRound reproduces
+     * it without reshuffling (see @ref Cards::Arrange).
+     *
+     * @param shoe Shoe shared by several tables.
+     */
+    void LoadShoe(const Cards& shoe);
+
+    /**
+     * @brief Gets read-only access to the shoe (seed, round, position).
+     */
+    const Cards& Shoe() const { return deck_; }
+
+private:
+
     /**
      * @brief Calculates dealer score with ace softening logic.
+     *
+     * Reads the running totals kept by @ref DealDealerCard, so the cost does
+     * not depend on the number of cards.
+     *
      * @return Current dealer total.
      */
-    int DealerHandScore() const;
+    int DealerHandScore() const { return DealerHandScore(rules_); }
+
+    /**
+     * @brief Dealer score under an explicit rule set (see @ref SettleRound).
+     */
+    template <class Rules>
+    int DealerHandScore(const Rules& rules) const {
+        return jaco_best_total(dealer_hard_total_, dealer_aces_, rules);
+    }
+
+    /**
+     * @brief Checks whether the dealer counts at least one ace as 11.
+     */
+    bool DealerIsSoft() const { return DealerHandScore() != dealer_hard_total_; }
+
+    /**
+     * @brief Deals one card to the dealer and updates the running totals.
+     */
+    void DealDealerCard();
+
+    /**
+     * @brief Clears the dealer hand and its running totals.
+     */
+    void ClearDealerHand();
     
     /**
      * @brief Ensures player containers are created up to @p player_index.
@@ -177,14 +315,20 @@ private:
     /** @brief Active rules governing limits and thresholds. */
     jaco_rules rules_;
 
-    /** @brief Current deck used for dealing. */
+    /** @brief Persistent multi-deck shoe used for dealing. */
     Cards deck_;
 
     /** @brief Players seated at the table (owned externally). */
     std::vector<jaco_player>& players_;
 
-    /** @brief Dealer current hand. */
-    Hand dealer_hand_;
+    /** @brief Dealer current hand, stored inline. */
+    jaco_fixed_vector<Card, jaco_player::kMaxHandCards> dealer_hand_;
+
+    /** @brief Dealer total with every ace counted as 1. */
+    int dealer_hard_total_;
+
+    /** @brief Number of aces in the dealer hand. */
+    int dealer_aces_;
 
     /** @brief Dealer bankroll. */
     int dealer_money_;
@@ -195,8 +339,8 @@ private:
     /** @brief Safe/insurance bet per player. */
     std::vector<int> safe_bets_;
 
-    /** @brief Bets per hand per player (supports splits). */
-    std::vector<std::vector<int>> hands_bets_;
+    /** @brief Bets per hand per player (supports splits), stored inline per seat. */
+    std::vector<jaco_fixed_vector<int, jaco_player::kMaxHands>> hands_bets_;
 };
 
 #endif // JACO_TABLE_H
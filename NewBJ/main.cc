@@ -1,5 +1,6 @@
 #include "NewBJ/jaco_game.h"
 #include "NewBJ/jaco_player.h"
+#include "NewBJ/jaco_rng.h"
 #include <iostream>
 #include <limits>
 #include <string>
@@ -19,7 +20,8 @@ int main() {
     players.emplace_back(i, rules);
   }
 
-  jaco_game game(rules, players);
+  // Only the interactive game draws a fresh seed; simulations pass their own.
+  jaco_game game(rules, players, jaco_rng::RandomSeed());
   
   while (!game.IsGameOver()) {
     game.PlayGame();
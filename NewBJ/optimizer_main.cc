@@ -0,0 +1,163 @@
+#include "NewBJ/jaco_chart_file.h"
+#include "NewBJ/jaco_optimizer.h"
+#include "NewBJ/jaco_strategy_solver.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  /**
+   * @brief Command line options of the strategy optimizer.
+   */
+  struct OptimizerOptions {
+    std::vector<jaco_rules::GameType> modes = {jaco_rules::GameType::CLASSIC,
+                                               jaco_rules::GameType::ROUND,
+                                               jaco_rules::GameType::EXTREME};
+    std::string start = "solver";     ///< Starting chart: solver, heuristic or a chart file
+    std::string output_prefix = "strategy";  ///< Charts are written to PREFIX_<mode>.jsc
+    jaco_optimizer::Config search;
+  };
+
+  void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " [--mode classic|round|extreme|all] [--start solver|heuristic|CHART]"
+                 " [--iterations N] [--time SECONDS] [--sessions N] [--rounds N]"
+                 " [--reseed N] [--validation N] [--players N] [--threads N]"
+                 " [--seed N] [--out PREFIX]\n";
+  }
+
+  bool ParseModes(const std::string& text, std::vector<jaco_rules::GameType>& modes) {
+    if (text == "all") {
+      modes = {jaco_rules::GameType::CLASSIC, jaco_rules::GameType::ROUND,
+               jaco_rules::GameType::EXTREME};
+      return true;
+    }
+    jaco_rules::GameType mode;
+    if (!jaco_rules::ParseMode(text, mode)) {
+      return false;
+    }
+    modes = {mode};
+    return true;
+  }
+
+  bool ParseOptions(int argc, char** argv, OptimizerOptions& options) {
+    auto& search = options.search;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (i + 1 >= argc) {
+        return false;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--mode") {
+        if (!ParseModes(value, options.modes)) return false;
+      } else if (arg == "--start") {
+        options.start = value;
+      } else if (arg == "--iterations") {
+        search.iterations = std::atoll(value.c_str());
+      } else if (arg == "--time") {
+        search.time_budget = std::atof(value.c_str());
+      } else if (arg == "--sessions") {
+        search.sessions = std::atoll(value.c_str());
+      } else if (arg == "--rounds") {
+        search.rounds_per_session = std::atoll(value.c_str());
+      } else if (arg == "--reseed") {
+        search.reseed_every = std::atoll(value.c_str());
+      } else if (arg == "--validation") {
+        search.validation_sessions = std::atoll(value.c_str());
+      } else if (arg == "--players") {
+        search.players = std::atoi(value.c_str());
+      } else if (arg == "--threads") {
+        search.threads = std::atoi(value.c_str());
+      } else if (arg == "--seed") {
+        search.seed = std::strtoull(value.c_str(), nullptr, 10);
+      } else if (arg == "--out") {
+        options.output_prefix = value;
+      } else {
+        return false;
+      }
+    }
+    return search.iterations >= 0 && search.sessions > 1 &&
+           search.rounds_per_session > 0 && search.validation_sessions > 1 &&
+           search.players > 0 && search.players <= ITable::kMaxPlayers;
+  }
+
+  /**
+   * @brief Builds the starting chart of a mode.
+   */
+  bool StartChart(const std::string& start, const jaco_rules& rules,
+                  int threads, jaco_strategy_chart& chart) {
+    if (start == "heuristic") {
+      chart = jaco_strategy_chart::Default(rules);
+      return true;
+    }
+    if (start == "solver") {
+      chart = jaco_strategy_solver(rules).Solve(threads);
+      return true;
+    }
+    jaco_chart_file file;
+    if (!file.Open(start) || file.WinPoint() != rules.GetWinPoint()) {
+      return false;
+    }
+    std::copy(file.Entries(), file.Entries() + jaco_strategy_chart::kEntries,
+              chart.data());
+    return true;
+  }
+
+  void PrintInterval(const char* label, const jaco_stats& stats) {
+    std::cout << label << stats.Mean() << " +/- " << stats.HalfWidth()
+              << " (95%, " << stats.Count() << " rounds)\n";
+  }
+
+}  // namespace
+
+/**
+ * @brief Entry point for the strategy optimizer.
+ *
+ * For every requested mode, improves a starting chart by simulation-scored
+ * local search, writes the best chart and reports its EV with confidence
+ * intervals.
+ */
+int main(int argc, char** argv) {
+  OptimizerOptions options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  for (const auto mode : options.modes) {
+    const jaco_rules rules(mode);
+    jaco_strategy_chart start;
+    if (!StartChart(options.start, rules, options.search.threads, start)) {
+      std::cerr << "Cannot load a " << jaco_rules::ModeName(mode) << " chart from "
+                << options.start << "\n";
+      return 1;
+    }
+
+    jaco_optimizer::Config search = options.search;
+    search.mode = mode;
+    jaco_optimizer optimizer(search);
+    const auto report = optimizer.Run(start);
+
+    const std::string path =
+        options.output_prefix + "_" + jaco_rules::ModeName(mode) + ".jsc";
+    if (!jaco_chart_file::Write(report.chart, rules.GetWinPoint(), path)) {
+      std::cerr << "Cannot write " << path << "\n";
+      return 1;
+    }
+
+    std::cout << "== " << jaco_rules::ModeName(mode) << " (seed " << optimizer.Seed()
+              << ") ==\n"
+              << jaco_strategy_solver::Format(report.chart, rules.GetWinPoint())
+              << "Iterations      : " << report.iterations << " ("
+              << report.accepted << " accepted) in " << report.elapsed << " s\n";
+    PrintInterval("Start EV        : ", report.start_ev);
+    PrintInterval("Best EV         : ", report.best_ev);
+    PrintInterval("Improvement     : ", report.improvement);
+    std::cout << "Chart           : " << path << "\n\n";
+  }
+  return 0;
+}
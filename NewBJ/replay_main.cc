@@ -0,0 +1,114 @@
+#include "NewBJ/jaco_replay.h"
+#include "NewBJ/jaco_chart_file.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+  /**
+   * @brief Command line options of the hand-history replay.
+   */
+  struct ReplayOptions {
+    std::string history_path;    ///< Hand history written by BlackjackSim --history
+    std::string strategy_path;   ///< Strategy chart file (empty = built-in)
+    jaco_replay::Config replay;
+  };
+
+  void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " --history FILE [--strategy CHART] [--threads N] [--batch N]\n"
+              << "  The game mode and penetration are read from the history.\n";
+  }
+
+  bool ParseOptions(int argc, char** argv, ReplayOptions& options) {
+    auto& replay = options.replay;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (i + 1 >= argc) {
+        return false;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--history") {
+        options.history_path = value;
+      } else if (arg == "--strategy") {
+        options.strategy_path = value;
+      } else if (arg == "--threads") {
+        replay.threads = std::atoi(value.c_str());
+      } else if (arg == "--batch") {
+        replay.batch_rounds = std::atoll(value.c_str());
+      } else {
+        return false;
+      }
+    }
+    return !options.history_path.empty() && replay.batch_rounds > 0;
+  }
+
+}  // namespace
+
+/**
+ * @brief Entry point for the hand-history replay.
+ *
+ * Plays every recorded round again on its recorded shoe with the requested
+ * chart and reports how the outcome differs from the recording.
+ */
+int main(int argc, char** argv) {
+  ReplayOptions options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  jaco_history_reader history;
+  if (!history.Open(options.history_path)) {
+    std::cerr << "Cannot read hand history " << options.history_path << "\n";
+    return 1;
+  }
+
+  jaco_chart_file chart;
+  if (!options.strategy_path.empty()) {
+    if (!chart.Open(options.strategy_path)) {
+      std::cerr << "Cannot load strategy chart " << options.strategy_path << "\n";
+      return 1;
+    }
+    if (chart.WinPoint() != jaco_rules(history.Mode()).GetWinPoint()) {
+      std::cerr << "Strategy chart was built for a win point of "
+                << chart.WinPoint() << "\n";
+      return 1;
+    }
+  }
+  options.replay.strategy = chart.Entries();
+
+  jaco_replay replay(history, options.replay);
+  const auto start = std::chrono::steady_clock::now();
+  const auto totals = replay.Run();
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  const double seat_rounds = static_cast<double>(totals.rounds) * history.Seats();
+  std::cout << "History         : " << options.history_path << " ("
+            << history.Seats() << " seats, " << jaco_rules::ModeName(history.Mode()) << ", "
+            << history.Penetration() << "% penetration)\n"
+            << "Threads         : " << replay.ThreadCount() << "\n"
+            << "Strategy        : "
+            << (options.strategy_path.empty() ? "built-in" : options.strategy_path)
+            << "\n"
+            << "Rounds          : " << totals.rounds << "\n"
+            << "Recorded net    : " << totals.recorded_net << " ("
+            << (seat_rounds > 0 ? totals.recorded_net / seat_rounds : 0.0)
+            << " per round and seat)\n"
+            << "Replayed net    : " << totals.replayed_net << " ("
+            << (seat_rounds > 0 ? totals.replayed_net / seat_rounds : 0.0)
+            << " per round and seat)\n"
+            << "Difference      : " << totals.difference.Mean() << " +/- "
+            << totals.difference.HalfWidth() << " (95% CI over rounds)\n"
+            << "Changed rounds  : " << totals.changed_rounds << "\n"
+            << "Approximate     : " << totals.approximate_rounds
+            << " rounds (shoe not restorable)\n"
+            << "Elapsed         : " << elapsed.count() << " s ("
+            << (elapsed.count() > 0 ? totals.rounds / elapsed.count() : 0.0)
+            << " rounds/s)\n";
+  return 0;
+}
@@ -0,0 +1,313 @@
+#include "NewBJ/jaco_simulator.h"
+#include "NewBJ/jaco_chart_file.h"
+#include "NewBJ/jaco_history_writer.h"
+#include "NewBJ/jaco_profile.h"
+#include "NewBJ/jaco_alloc.h"
+#include "NewBJ/jaco_perf.h"
+#include "Interface/itable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+  /**
+   * @brief Prints the EV interval of every seat on one line.
+   */
+  void PrintSeats(const std::vector<jaco_stats>& seats) {
+    for (size_t i = 0; i < seats.size(); ++i) {
+      std::cout << (i == 0 ? "" : ", ") << seats[i].Mean() << " +/- "
+                << seats[i].HalfWidth();
+    }
+    std::cout << " (95% CI over rounds)\n";
+  }
+
+  /**
+   * @brief Command line options of the headless simulator.
+   */
+  struct SimOptions {
+    jaco_rules::GameType mode = jaco_rules::GameType::CLASSIC;
+    long long rounds = 1000000;  ///< Round limit per session (0 = until game over)
+    long long sessions = 1;      ///< Number of independent sessions
+    int players = 4;             ///< Players seated at the table
+    int threads = 0;             ///< Worker threads (0 = all cores)
+    int penetration = jaco_rules::kShoePenetration;  ///< Cut card position in percent
+    std::uint64_t seed = 0;      ///< Master seed (0 = random)
+    bool virtual_dispatch = false;  ///< Play through the IPlayer/ITable interfaces
+    std::string strategy_path;   ///< Strategy chart file (empty = built-in)
+    std::vector<std::string> compare;  ///< Charts compared on the same shoes ("builtin" = built-in)
+    double target = 0.0;         ///< Stop at this 95% CI half-width (0 = off)
+    long long min_rounds = 10000;  ///< Rounds before the interval is trusted
+    double time_budget = 0.0;    ///< Wall-clock limit in seconds (0 = none)
+    std::string history_path;    ///< Binary hand history file (empty = none)
+    double profile_every = 0.0;  ///< Phase report period in seconds (0 = at the end only)
+    bool perf = false;           ///< Read hardware performance counters
+    bool perf_phases = false;    ///< Split them by round phase
+  };
+
+  /** @brief Name that selects the built-in chart in a comparison. */
+  const char* const kBuiltinChart = "builtin";
+
+  void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " [--mode classic|round|extreme] [--rounds N]"
+                 " [--sessions N] [--players N] [--threads N]"
+                 " [--penetration PERCENT] [--seed N]"
+                 " [--dispatch static|virtual] [--strategy CHART]"
+                 " [--compare CHART,CHART[,...]]"
+                 " [--target HALF_WIDTH] [--min-rounds N] [--time SECONDS]"
+                 " [--history FILE] [--profile-every SECONDS] [--perf on|phases|off]\n"
+              << "  --compare plays every chart on the same shoes; use "
+              << kBuiltinChart << " for the built-in chart.\n"
+              << "  --target and --time stop early; --sessions becomes an upper bound.\n"
+              << "  --history with --compare records the first chart's table.\n"
+              << "  --profile-every and --perf phases need a build with JACO_PROFILE_PHASES=1;\n"
+              << "  --perf on counts totals only and adds no reads to the rounds.\n";
+  }
+
+  std::vector<std::string> SplitList(const std::string& text) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    while (begin <= text.size()) {
+      const size_t end = std::min(text.find(',', begin), text.size());
+      items.push_back(text.substr(begin, end - begin));
+      begin = end + 1;
+    }
+    return items;
+  }
+
+  /**
+   * @brief Maps a chart file and checks that it was built for @p mode.
+   */
+  bool OpenChart(const std::string& path, jaco_rules::GameType mode,
+                 jaco_chart_file& chart) {
+    if (!chart.Open(path)) {
+      std::cerr << "Cannot load strategy chart " << path << "\n";
+      return false;
+    }
+    if (chart.WinPoint() != jaco_rules(mode).GetWinPoint()) {
+      std::cerr << "Strategy chart " << path << " was built for a win point of "
+                << chart.WinPoint() << "\n";
+      return false;
+    }
+    return true;
+  }
+
+  bool ParseOptions(int argc, char** argv, SimOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (i + 1 >= argc) {
+        return false;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--mode") {
+        if (!jaco_rules::ParseMode(value, options.mode)) return false;
+      } else if (arg == "--rounds") {
+        options.rounds = std::atoll(value.c_str());
+      } else if (arg == "--sessions") {
+        options.sessions = std::atoll(value.c_str());
+      } else if (arg == "--players") {
+        options.players = std::atoi(value.c_str());
+      } else if (arg == "--threads") {
+        options.threads = std::atoi(value.c_str());
+      } else if (arg == "--penetration") {
+        options.penetration = std::atoi(value.c_str());
+      } else if (arg == "--seed") {
+        options.seed = std::strtoull(value.c_str(), nullptr, 10);
+      } else if (arg == "--dispatch") {
+        if (value != "static" && value != "virtual") return false;
+        options.virtual_dispatch = value == "virtual";
+      } else if (arg == "--strategy") {
+        options.strategy_path = value;
+      } else if (arg == "--target") {
+        options.target = std::atof(value.c_str());
+      } else if (arg == "--min-rounds") {
+        options.min_rounds = std::atoll(value.c_str());
+      } else if (arg == "--time") {
+        options.time_budget = std::atof(value.c_str());
+      } else if (arg == "--history") {
+        options.history_path = value;
+      } else if (arg == "--profile-every") {
+        options.profile_every = std::atof(value.c_str());
+      } else if (arg == "--perf") {
+        if (value != "on" && value != "phases" && value != "off") return false;
+        options.perf = value != "off";
+        options.perf_phases = value == "phases";
+      } else if (arg == "--compare") {
+        options.compare = SplitList(value);
+        for (const auto& item : options.compare) {
+          if (item.empty()) return false;
+        }
+      } else {
+        return false;
+      }
+    }
+    return options.rounds >= 0 && options.sessions > 0 &&
+           options.players > 0 && options.players <= ITable::kMaxPlayers &&
+           options.penetration > 0 && options.penetration <= 100 &&
+           options.compare.size() != 1 && options.target >= 0.0 &&
+           options.min_rounds >= 0 && options.time_budget >= 0.0 &&
+           options.profile_every >= 0.0;
+  }
+
+}  // namespace
+
+/**
+ * @brief Entry point for the headless Blackjack simulator.
+ *
+ * Plays the requested number of sessions on all cores with every
+ * presentation path compiled out (JACO_HEADLESS) and prints a single
+ * summary at the end.
+ */
+int main(int argc, char** argv) {
+  SimOptions options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  // Mapped once and shared read-only by every worker.
+  jaco_chart_file chart;
+  if (!options.strategy_path.empty() &&
+      !OpenChart(options.strategy_path, options.mode, chart)) {
+    return 1;
+  }
+  std::vector<std::unique_ptr<jaco_chart_file>> compared;
+  std::vector<const std::uint8_t*> compare_entries;
+  for (const auto& path : options.compare) {
+    compared.push_back(std::make_unique<jaco_chart_file>());
+    if (path != kBuiltinChart && !OpenChart(path, options.mode, *compared.back())) {
+      return 1;
+    }
+    compare_entries.push_back(compared.back()->Entries());
+  }
+
+  jaco_history_writer history;
+  jaco_rules history_rules(options.mode);
+  history_rules.SetPenetration(options.penetration);
+  if (!options.history_path.empty() &&
+      !history.Open(options.history_path, options.players, history_rules)) {
+    std::cerr << "Cannot create hand history " << options.history_path << "\n";
+    return 1;
+  }
+
+  // Counters are optional: report why they are missing and carry on.
+  if (options.perf) {
+    std::string reason;
+    if (!jaco_perf::Probe(reason)) {
+      std::cerr << "Hardware counters unavailable: " << reason
+                << "; running without them\n";
+      options.perf = false;
+    }
+  }
+
+  jaco_simulator::Config config;
+  config.mode = options.mode;
+  config.sessions = options.sessions;
+  config.rounds_per_session = options.rounds;
+  config.players = options.players;
+  config.threads = options.threads;
+  config.penetration = options.penetration;
+  config.seed = options.seed;
+  config.virtual_dispatch = options.virtual_dispatch;
+  config.strategy = chart.Entries();
+  config.compare = compare_entries;
+  config.target_half_width = options.target;
+  config.min_rounds = options.min_rounds;
+  config.time_budget = options.time_budget;
+  config.history = options.history_path.empty() ? nullptr : &history;
+  config.perf_counters = options.perf;
+  config.perf_phases = options.perf_phases;
+
+  jaco_simulator simulator(config);
+  jaco_profile::StartReporting(options.profile_every, std::cerr);
+  const jaco_alloc::Snapshot allocations = jaco_alloc::Collect();
+  const auto start = std::chrono::steady_clock::now();
+  const auto totals = simulator.Run();
+  jaco_profile::StopReporting();
+  const jaco_alloc::Snapshot run_allocations = jaco_alloc::Collect().Since(allocations);
+  if (!history.Close()) {
+    std::cerr << "Cannot write hand history " << options.history_path << "\n";
+    return 1;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  const jaco_rules rules(options.mode);
+  const double player_rounds =
+      static_cast<double>(totals.rounds) * options.players;
+  const double ev_per_round =
+      player_rounds > 0 ? totals.player_net / player_rounds : 0.0;
+
+  std::cout << "Seed            : " << simulator.Seed() << "\n"
+            << "Threads         : " << simulator.ThreadCount() << "\n"
+            << "Dispatch        : "
+            << (options.virtual_dispatch ? "virtual" : "static") << "\n"
+            << "Strategy        : "
+            << (!options.compare.empty()      ? "paired comparison"
+                : options.strategy_path.empty() ? "built-in"
+                                                : options.strategy_path)
+            << "\n"
+            << "Sessions        : " << totals.sessions
+            << " (" << totals.steals << " stolen)\n"
+            << "Rounds          : " << totals.rounds << "\n"
+            << "Hands           : " << totals.hands << "\n"
+            << "Wins/Losses/Ties: " << totals.wins << " / " << totals.losses
+            << " / " << totals.ties << "\n"
+            << "Player net      : " << totals.player_net << "\n"
+            << "Dealer net      : " << totals.dealer_net << "\n"
+            << "EV per round    : " << ev_per_round << " ("
+            << 100.0 * ev_per_round / rules.MinimumInitialBet()
+            << "% of minimum bet)\n"
+            << "Session EV      : " << totals.session_ev.Mean() << " +/- "
+            << totals.session_ev.HalfWidth() << " (95% CI over sessions)\n"
+            << "Round EV        : " << totals.round_ev.Mean() << " +/- "
+            << totals.round_ev.HalfWidth() << " (95% CI over rounds)\n"
+            << "Seat EV         : ";
+  PrintSeats(totals.seat_ev);
+  std::cout << "Stopped         : "
+            << (totals.converged   ? "target interval reached"
+                : totals.timed_out ? "time budget spent"
+                                   : "all sessions played")
+            << "\n"
+            << "Elapsed         : " << elapsed.count() << " s ("
+            << (elapsed.count() > 0 ? totals.rounds / elapsed.count() : 0.0)
+            << " rounds/s)\n";
+
+  // Paired mode: every chart was dealt the same cards, round by round.
+  for (size_t i = 0; i < totals.strategies.size(); ++i) {
+    const auto& strategy = totals.strategies[i];
+    std::cout << "Chart " << i + 1 << "         : " << options.compare[i]
+              << "\n"
+              << "  Player net    : " << strategy.player_net << "\n"
+              << "  Round EV      : " << strategy.round_ev.Mean() << " +/- "
+              << strategy.round_ev.HalfWidth() << " (95% CI over rounds)\n"
+              << "  Seat EV       : ";
+    PrintSeats(strategy.seat_ev);
+    if (i > 0) {
+      std::cout << "  vs chart 1    : " << strategy.difference.Mean() << " +/- "
+                << strategy.difference.HalfWidth()
+                << " (95% CI of the paired round difference)\n";
+    }
+  }
+
+  if (jaco_profile::kEnabled) {
+    std::cout << "Round phases    :\n";
+    jaco_profile::Report(std::cout, jaco_profile::Collect());
+  }
+  if (options.perf) {
+    std::cout << "Hardware counters:\n";
+    jaco_perf::Report(std::cout, jaco_perf::Collect(), totals.rounds);
+  }
+  if (jaco_alloc::kEnabled) {
+    // Includes building every session's table; see BlackjackBench for steady state.
+    std::cout << "Allocations     :\n";
+    jaco_alloc::Report(std::cout, run_allocations, totals.rounds);
+  }
+  return 0;
+}
@@ -0,0 +1,122 @@
+#include "NewBJ/jaco_chart_file.h"
+#include "NewBJ/jaco_dealer_odds.h"
+#include "NewBJ/jaco_strategy_solver.h"
+#include "NewBJ/jaco_rules.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+  /**
+   * @brief Command line options of the analytic solver.
+   */
+  struct SolverOptions {
+    jaco_rules::GameType mode = jaco_rules::GameType::CLASSIC;
+    std::string cache_directory;  ///< Disk cache for dealer tables (empty = none)
+    bool dealer_table = false;    ///< Print the dealer outcomes instead of the strategy
+    int threads = 0;              ///< Solver threads (0 = one per upcard)
+    std::string output_path;      ///< Binary chart written for BlackjackSim (empty = none)
+  };
+
+  void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program
+              << " [--mode classic|round|extreme] [--table strategy|dealer]"
+                 " [--threads N] [--cache DIRECTORY] [--out CHART]\n";
+  }
+
+  bool ParseOptions(int argc, char** argv, SolverOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (i + 1 >= argc) {
+        return false;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--mode") {
+        if (!jaco_rules::ParseMode(value, options.mode)) return false;
+      } else if (arg == "--cache") {
+        options.cache_directory = value;
+      } else if (arg == "--table") {
+        if (value != "strategy" && value != "dealer") return false;
+        options.dealer_table = value == "dealer";
+      } else if (arg == "--threads") {
+        options.threads = std::atoi(value.c_str());
+      } else if (arg == "--out") {
+        options.output_path = value;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const char* RankName(int rank) {
+    static const char* const kNames[] = {"A", "2", "3", "4", "5",
+                                         "6", "7", "8", "9", "T"};
+    return kNames[rank];
+  }
+
+  /**
+   * @brief Prints the dealer's final-outcome table, one row per upcard.
+   */
+  void PrintDealerTable(const jaco_dealer_odds& odds,
+                        const jaco_dealer_odds::Table& table) {
+    std::printf("Dealer outcomes (win point %d, dealer stops at %d)\n",
+                odds.WinPoint(), odds.DealerStop());
+    std::printf("Up ");
+    for (int score = odds.DealerStop(); score <= odds.WinPoint(); ++score) {
+      std::printf("%7d", score);
+    }
+    std::printf("   Bust     BJ\n");
+    for (int upcard = 0; upcard < jaco_dealer_odds::kNumRanks; ++upcard) {
+      const auto& outcome = table[upcard];
+      std::printf("%-3s", RankName(upcard));
+      for (int score = odds.DealerStop(); score <= odds.WinPoint(); ++score) {
+        std::printf("%7.4f", outcome.total[score]);
+      }
+      std::printf("%7.4f%7.4f\n", outcome.bust, outcome.blackjack);
+    }
+  }
+
+}  // namespace
+
+/**
+ * @brief Entry point for the analytic Blackjack solver.
+ *
+ * Prints the basic-strategy chart, or the exact dealer outcome table, for a
+ * fresh shoe of the chosen mode.
+ */
+int main(int argc, char** argv) {
+  SolverOptions options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  const jaco_rules rules(options.mode);
+  const auto start = std::chrono::steady_clock::now();
+  if (options.dealer_table) {
+    jaco_dealer_odds odds(rules);
+    odds.SetCacheDirectory(options.cache_directory);
+    const auto table =
+        odds.ComputeAll(jaco_dealer_odds::FullShoe(rules.NumberOfDecks()));
+    PrintDealerTable(odds, table);
+  } else {
+    const jaco_strategy_solver solver(rules);
+    const auto chart = solver.Solve(options.threads);
+    std::cout << "Basic strategy (win point " << rules.GetWinPoint()
+              << ", " << rules.NumberOfDecks() << " deck(s))\n"
+              << jaco_strategy_solver::Format(chart, rules.GetWinPoint());
+    if (!options.output_path.empty() &&
+        !jaco_chart_file::Write(chart, rules.GetWinPoint(), options.output_path)) {
+      std::cerr << "Cannot write " << options.output_path << "\n";
+      return 1;
+    }
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cout << "Elapsed: " << elapsed.count() << " s\n";
+  return 0;
+}
@@ -4,54 +4,137 @@ workspace "Blackjack"
     startproject "Blackjack"
     location "build"
 
-------------------------
--- Executable: Blackjack
-------------------------
-project "Blackjack"
-    kind "ConsoleApp"
-    language "C++"
-    cppdialect "C++17"
-
-    -- Source files for the NewBJ implementation
-    files {
-        "NewBJ/main.cc",
-        "NewBJ/jaco_player.h",
-        "NewBJ/jaco_game.h",
-        "NewBJ/jaco_table.h",
-        "NewBJ/jaco_rules.h",
-        "NewBJ/cards.h",
-        "NewBJ/jaco_game.cc",
-        "NewBJ/jaco_table.cc",
-        "NewBJ/jaco_player.cc",
-        "NewBJ/cards.cc",
-        "NewBJ/jaco_rules.cc"
-    }
-
-    -- Root include dirs for headers
-    includedirs {
-        ".",
-        "NewBJ",
-        "Interface"
-    }
-
-    -- External lib dirs (none required currently)
-    libdirs {
-        "."
-    }
-
-    -- Libraries to link (empty placeholder)
-    links {
-    }
-
-    filter "system:windows"
-        systemversion "latest"
-
-    filter "configurations:Debug"
-        defines { "DEBUG" }
-        runtime "Debug"
-        symbols "On"
-
-    filter "configurations:Release"
-        defines { "NDEBUG" }
-        runtime "Release"
-        optimize "On"
+-- Engine sources shared by every executable
+local engine_files = {
+    "NewBJ/jaco_player.h",
+    "NewBJ/jaco_game.h",
+    "NewBJ/jaco_table.h",
+    "NewBJ/jaco_rules.h",
+    "NewBJ/jaco_rules_policy.h",
+    "NewBJ/cards.h",
+    "NewBJ/jaco_rng.h",
+    "NewBJ/jaco_fixed_vector.h",
+    "NewBJ/jaco_simulator.h",
+    "NewBJ/jaco_dealer_odds.h",
+    "NewBJ/jaco_strategy_chart.h",
+    "NewBJ/jaco_strategy_solver.h",
+    "NewBJ/jaco_chart_file.h",
+    "NewBJ/jaco_stats.h",
+    "NewBJ/jaco_optimizer.h",
+    "NewBJ/jaco_log.h",
+    "NewBJ/jaco_history_format.h",
+    "NewBJ/jaco_history_writer.h",
+    "NewBJ/jaco_history_reader.h",
+    "NewBJ/jaco_replay.h",
+    "NewBJ/jaco_profile.h",
+    "NewBJ/jaco_alloc.h",
+    "NewBJ/jaco_perf.h",
+    "NewBJ/jaco_game.cc",
+    "NewBJ/jaco_table.cc",
+    "NewBJ/jaco_player.cc",
+    "NewBJ/cards.cc",
+    "NewBJ/jaco_rules.cc",
+    "NewBJ/jaco_simulator.cc",
+    "NewBJ/jaco_dealer_odds.cc",
+    "NewBJ/jaco_strategy_solver.cc",
+    "NewBJ/jaco_strategy_chart.cc",
+    "NewBJ/jaco_chart_file.cc",
+    "NewBJ/jaco_optimizer.cc",
+    "NewBJ/jaco_log.cc",
+    "NewBJ/jaco_history_writer.cc",
+    "NewBJ/jaco_history_reader.cc",
+    "NewBJ/jaco_replay.cc",
+    "NewBJ/jaco_profile.cc",
+    "NewBJ/jaco_alloc.cc",
+    "NewBJ/jaco_perf.cc"
+}
+
+-- premake5 gmake2 --profile-phases: time every round phase (see jaco_profile.h)
+newoption {
+    trigger = "profile-phases",
+    description = "Compile the per-phase round timers in (JACO_PROFILE_PHASES=1)"
+}
+filter "options:profile-phases"
+    defines { "JACO_PROFILE_PHASES=1" }
+filter {}
+
+-- premake5 gmake2 --alloc-accounting: count heap allocations (see jaco_alloc.h)
+newoption {
+    trigger = "alloc-accounting",
+    description = "Count heap allocations by subsystem (JACO_ALLOC_ACCOUNTING=1)"
+}
+filter "options:alloc-accounting"
+    defines { "JACO_ALLOC_ACCOUNTING=1" }
+filter {}
+
+-- Declares one console executable: its entry point(s) plus the shared engine,
+-- with the same include dirs, links and build flags as every other target.
+-- headless compiles every console print out (JACO_HEADLESS, JACO_LOG_LEVEL 0).
+function engine_app(name, main_files, headless)
+    project(name)
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++17"
+
+        files(main_files)
+        files(engine_files)
+
+        if headless then
+            defines { "JACO_HEADLESS" }
+        end
+
+        -- Root include dirs for headers
+        includedirs {
+            ".",
+            "NewBJ",
+            "Interface"
+        }
+
+        -- External lib dirs (none required currently)
+        libdirs {
+            "."
+        }
+
+        -- The game log prints from a background thread
+        filter "system:linux"
+            links { "pthread" }
+
+        filter "system:windows"
+            systemversion "latest"
+
+        filter "configurations:Debug"
+            defines { "DEBUG" }
+            runtime "Debug"
+            symbols "On"
+
+        filter "configurations:Release"
+            defines { "NDEBUG" }
+            runtime "Release"
+            optimize "On"
+            -- Lets the static-dispatch round loop inline across translation units
+            flags { "LinkTimeOptimization" }
+
+        filter {}
+end
+
+-- Interactive game
+engine_app("Blackjack", { "NewBJ/main.cc" }, false)
+
+-- Batch simulation
+engine_app("BlackjackSim", { "NewBJ/sim_main.cc" }, true)
+
+-- Exact dealer odds and basic-strategy charts, no game loop
+engine_app("BlackjackSolver", { "NewBJ/solver_main.cc" }, true)
+
+-- Long-running local search over strategy charts on every core
+engine_app("BlackjackOptimizer", { "NewBJ/optimizer_main.cc" }, true)
+
+-- Re-scores a chart on the shoes of a recorded hand history
+engine_app("BlackjackReplay", { "NewBJ/replay_main.cc" }, true)
+
+-- Times the shoe, player, table and round hot paths; median/p99 and JSON
+engine_app("BlackjackBench", {
+    "NewBJ/bench_main.cc",
+    "NewBJ/jaco_bench.h",
+    "NewBJ/jaco_bench.cc"
+}, true)